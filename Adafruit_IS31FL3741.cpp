@@ -1,5 +1,15 @@
 #include <Adafruit_IS31FL3741.h>
 
+#if defined(__SSE2__) // Bulk buffer kernels, see _IS31dim() and _IS31blend()
+#include <emmintrin.h>
+#if defined(__GNUC__) // GCC & clang can add AVX2 paths chosen at run time
+#include <immintrin.h>
+#define _IS31_AVX2_ __attribute__((target("avx2")))
+#endif
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 // drawPixel() and setPixelColor() for various classes are all doing
 // certain things similarly, but not exactly 100%. These #defines encompass
 // the similar parts, done this way (rather than functions) to avoid call
@@ -56,6 +66,30 @@
   _G_ = ((uint16_t)_G_ * _BRIGHTNESS_) >> 8;                                   \
   _B_ = ((uint16_t)_B_ * _BRIGHTNESS_) >> 8;
 
+// This adds an 8-bit value to an LED buffer element, clipping at 255
+// rather than wrapping around, for additive drawing (e.g. particles).
+#define _IS31_ADD_SAT_(_PTR_, _VALUE_)                                         \
+  {                                                                            \
+    uint16_t _sum_ = *(_PTR_) + (_VALUE_);                                     \
+    *(_PTR_) = (_sum_ > 255) ? 255 : _sum_;                                    \
+  }
+
+// Full memory barrier for lock-free handoff between cores (triple
+// buffering): all reads & writes before it complete before any after.
+// GCC & clang pick the right fence for the exact core, e.g. dmb on
+// ARMv7 & M0+, a CP15 barrier on classic ARMv6 (which lacks dmb), memw
+// on Xtensa, and just a compiler barrier on single-core AVR. Inline asm
+// is only for other compilers.
+#if defined(__GNUC__)
+#define _IS31_MEMORY_BARRIER() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#elif defined(__arm__)
+#define _IS31_MEMORY_BARRIER() __asm__ volatile("dmb" ::: "memory")
+#elif defined(__XTENSA__)
+#define _IS31_MEMORY_BARRIER() __asm__ volatile("memw" ::: "memory")
+#else
+#error "No memory barrier for this compiler, see _IS31_MEMORY_BARRIER()"
+#endif
+
 // IS31FL3741 (DIRECT, UNBUFFERED) -----------------------------------------
 // Most of these functions are also used by the IS31 buffered subclass,
 // only a few are overloaded. Those appear later.
@@ -71,15 +105,17 @@
 bool Adafruit_IS31FL3741::begin(uint8_t addr, TwoWire *theWire) {
   delete _i2c_dev;
   _i2c_dev = new Adafruit_I2CDevice(addr, theWire);
+  _page = -1;   // Chip's page is unknown, don't trust any prior cache
+  _config = -1; // Nor its configuration register
 
   if (_i2c_dev->begin()) {
     // User code can set this faster if it wants, this is simply
     // the max ordained I2C speed on AVR.
     _i2c_dev->setSpeed(400000);
 
-    Adafruit_BusIO_Register id_reg =
-        Adafruit_BusIO_Register(_i2c_dev, IS3741_IDREGISTER);
-    if ((id_reg.read() == (addr * 2)) && reset()) {
+    uint8_t id = 0;
+    if (readRegisters(IS3741_IDREGISTER, &id, 1) && (id == (addr * 2)) &&
+        reset()) {
       return true; // Success!
     }
   }
@@ -95,9 +131,11 @@ bool Adafruit_IS31FL3741::begin(uint8_t addr, TwoWire *theWire) {
 /**************************************************************************/
 bool Adafruit_IS31FL3741::reset(void) {
   selectPage(4);
-  Adafruit_BusIO_Register reset_reg =
-      Adafruit_BusIO_Register(_i2c_dev, IS3741_FUNCREG_RESET);
-  return reset_reg.write(0xAE);
+  if (!writeRegister(IS3741_FUNCREG_RESET, 0xAE))
+    return false;
+  _config = 0;  // Power-on default: shutdown, all 9 scan lines
+  _pwmFreq = 0; // and 29 kHz PWM
+  return true;
 }
 
 /**************************************************************************/
@@ -108,12 +146,7 @@ bool Adafruit_IS31FL3741::reset(void) {
 */
 /**************************************************************************/
 bool Adafruit_IS31FL3741::enable(bool en) {
-  selectPage(4);
-  Adafruit_BusIO_Register config_reg =
-      Adafruit_BusIO_Register(_i2c_dev, IS3741_FUNCREG_CONFIG);
-  Adafruit_BusIO_RegisterBits shutdown_bit =
-      Adafruit_BusIO_RegisterBits(&config_reg, 1, 0);
-  return shutdown_bit.write(en);
+  return writeConfig(0xFE, en); // Shutdown bit is bit 0
 }
 
 /**************************************************************************/
@@ -125,9 +158,7 @@ bool Adafruit_IS31FL3741::enable(bool en) {
 /**************************************************************************/
 bool Adafruit_IS31FL3741::setGlobalCurrent(uint8_t current) {
   selectPage(4);
-  Adafruit_BusIO_Register gcurr_reg =
-      Adafruit_BusIO_Register(_i2c_dev, IS3741_FUNCREG_GCURRENT);
-  return gcurr_reg.write(current);
+  return writeRegister(IS3741_FUNCREG_GCURRENT, current);
 }
 
 /**************************************************************************/
@@ -138,9 +169,121 @@ bool Adafruit_IS31FL3741::setGlobalCurrent(uint8_t current) {
 /**************************************************************************/
 uint8_t Adafruit_IS31FL3741::getGlobalCurrent(void) {
   selectPage(4);
-  Adafruit_BusIO_Register gcurr_reg =
-      Adafruit_BusIO_Register(_i2c_dev, IS3741_FUNCREG_GCURRENT);
-  return gcurr_reg.read();
+  uint8_t current = 0;
+  readRegisters(IS3741_FUNCREG_GCURRENT, &current, 1);
+  return current;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Set how many SW (scan) lines the chip cycles through, from
+              the full 9 (power-on default) down to 2. A panel wired to
+              fewer SW lines then gets a larger share of each scan cycle
+              per LED: brighter at the same current, or the same
+              brightness at a lower setGlobalCurrent(). Lines are always
+              SW1 up to the count given; LEDs on higher lines go dark.
+    @param    lines  Number of SW lines in use, 2 to 9.
+    @returns  true if I2C command acknowledged, false if out of range or
+              on I2C error.
+    @note     All of the boards supported by this library (EVB, STEMMA QT
+              matrix, EyeLights) have LEDs on all 9 lines, so this is only
+              of use with custom hardware. A reset() restores 9 lines.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741::setScanLines(uint8_t lines) {
+  if ((lines < 2) || (lines > 9))
+    return false;
+  return writeConfig(0x0F, (9 - lines) << 4); // SWS bits are 7:4
+}
+
+/**************************************************************************/
+/*!
+    @brief    Get the number of SW (scan) lines the chip cycles through.
+    @returns  2 to 9, or 0 on I2C error or if the chip is in no-scan mode.
+*/
+/**************************************************************************/
+uint8_t Adafruit_IS31FL3741::getScanLines(void) {
+  if (_config < 0) {
+    uint8_t config;
+    selectPage(4);
+    if (!readRegisters(IS3741_FUNCREG_CONFIG, &config, 1))
+      return 0;
+    _config = config;
+  }
+  uint8_t sws = _config >> 4; // 0 = 9 lines, 7 = 2 lines, 8 = no scan
+  return (sws < 8) ? (9 - sws) : 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Set the frequency at which LEDs are PWM-switched. Higher
+              frequencies avoid banding on video from rolling-shutter
+              cameras (IS3741_PWM_CAMERA); lower ones switch less often,
+              for less power lost in switching and less electrical noise
+              near sensitive circuits (IS3741_PWM_LOWPOWER). LED data is
+              unaffected. The setting is cached for getPWMFrequency(), and
+              a reset (incl. begin()) restores the 29 kHz default. That's
+              also the chip's fastest, so IS3741_PWM_CAMERA only matters
+              after a lower frequency was set.
+    @param    freq  One of the IS3741_PWM_* values.
+    @returns  true if I2C command acknowledged, false on error.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741::setPWMFrequency(IS3741_pwmFreq freq) {
+  selectPage(4);
+  if (!writeRegister(IS3741_FUNCREG_PWMFREQ, freq))
+    return false;
+  _pwmFreq = freq;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Get the PWM frequency last set. This is cached, so it's only
+              read from the chip if unknown (before begin(), or after
+              writeRaw() may have changed it).
+    @returns  IS3741_pwmFreq  One of the IS3741_PWM_* values.
+*/
+/**************************************************************************/
+IS3741_pwmFreq Adafruit_IS31FL3741::getPWMFrequency(void) {
+  if (_pwmFreq < 0) {
+    uint8_t freq = 0;
+    selectPage(4);
+    if (readRegisters(IS3741_FUNCREG_PWMFREQ, &freq, 1))
+      _pwmFreq = freq & 0x0F;
+    return (IS3741_pwmFreq)(freq & 0x0F);
+  }
+  return (IS3741_pwmFreq)_pwmFreq;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Change some bits of the configuration register (shutdown,
+              scan lines, etc.). The register's value is cached, so it's
+              only read from the chip the first time (or after writeRaw()
+              touches page 4). After that, a call is a single 2-byte write
+              if page 4 is still selected, else an unlock, page select and
+              write (3 transactions), e.g. when show() ran in between.
+    @param    keep  Mask of bits to keep from the current value.
+    @param    set   Bits to set, OR'd with the kept ones.
+    @returns  true if I2C transfers acknowledged, false on error.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741::writeConfig(uint8_t keep, uint8_t set) {
+  selectPage(4);
+  if (_config < 0) {
+    uint8_t config;
+    if (!readRegisters(IS3741_FUNCREG_CONFIG, &config, 1))
+      return false;
+    _config = config;
+  }
+  uint8_t config = (_config & keep) | set;
+  if (!writeRegister(IS3741_FUNCREG_CONFIG, config)) {
+    _config = -1; // Not sure what the chip has now
+    return false;
+  }
+  _config = config;
+  return true;
 }
 
 /**************************************************************************/
@@ -150,9 +293,7 @@ uint8_t Adafruit_IS31FL3741::getGlobalCurrent(void) {
 */
 /**************************************************************************/
 bool Adafruit_IS31FL3741::unlock(void) {
-  Adafruit_BusIO_Register lock_reg =
-      Adafruit_BusIO_Register(_i2c_dev, IS3741_COMMANDREGISTERLOCK);
-  return lock_reg.write(0xC5);
+  return writeRegister(IS3741_COMMANDREGISTERLOCK, 0xC5);
 }
 
 /**************************************************************************/
@@ -172,13 +313,108 @@ bool Adafruit_IS31FL3741::selectPage(uint8_t page) {
     _page = page; // Cache this page value
 
     unlock();
-    Adafruit_BusIO_Register cmd_reg =
-        Adafruit_BusIO_Register(_i2c_dev, IS3741_COMMANDREGISTER);
-    return cmd_reg.write(page);
+    return writeRegister(IS3741_COMMANDREGISTER, page);
   }
   return false; // Invalid page
 }
 
+/**************************************************************************/
+/*!
+    @brief    Write bytes to the chip. ALL I2C writes go through here (or
+              the register functions below, which use this), so a trace
+              sink set with setTrace() sees every transaction.
+    @param    buf  Register address followed by data.
+    @param    len  Total bytes to write, including address.
+    @returns  true if I2C transfer acknowledged, false on error.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741::i2cWrite(const uint8_t *buf, uint16_t len) {
+  if (_trace) {
+    uint32_t t = micros();
+    bool ok = _i2c_dev->write(buf, len);
+    _trace->record(t, _i2c_dev->address(), ok ? 0 : IS3741_TRACE_FAIL, buf,
+                   len);
+    return ok;
+  }
+  return _i2c_dev->write(buf, len);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Write a single 8-bit register on the currently-selected page
+              (or one of the page-independent command registers).
+    @param    reg    Register address.
+    @param    value  Value to write.
+    @returns  true if I2C transfer acknowledged, false on error.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741::writeRegister(uint8_t reg, uint8_t value) {
+  uint8_t cmd[2] = {reg, value};
+  return i2cWrite(cmd, 2);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Read one or more consecutive registers. As with i2cWrite(),
+              this is reported to any trace sink; the data passed along
+              is the register address followed by the bytes read.
+    @param    reg  First register address.
+    @param    buf  Buffer to receive values.
+    @param    len  Number of registers to read (up to 8 if tracing).
+    @returns  true if I2C transfer acknowledged, false on error.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741::readRegisters(uint8_t reg, uint8_t *buf,
+                                        uint8_t len) {
+  bool ok = _i2c_dev->write_then_read(&reg, 1, buf, len);
+  if (_trace) {
+    uint8_t data[9]; // Register + up to 8 bytes read
+    if (len > 8)
+      len = 8;
+    data[0] = reg;
+    memcpy(&data[1], buf, len);
+    _trace->record(micros(), _i2c_dev->address(),
+                   IS3741_TRACE_READ | (ok ? 0 : IS3741_TRACE_FAIL), data,
+                   len + 1);
+  }
+  return ok;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Send raw bytes straight to the chip: a register address
+              followed by data, as captured in a trace. For replaying
+              traces (see Adafruit_IS31FL3741_TraceReplay) or experiments,
+              not normal use. Keeps the cached page number in sync if the
+              write selects a page, and re-reads the configuration and PWM
+              frequency registers on next use if it might have changed them.
+    @param    buf  Register address followed by data.
+    @param    len  Total bytes to write, including address.
+    @returns  true if I2C transfer acknowledged, false on error.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741::writeRaw(const uint8_t *buf, uint16_t len) {
+  if ((len >= 2) && (buf[0] == IS3741_COMMANDREGISTER))
+    _page = (buf[1] < 5) ? buf[1] : -1;
+  else if ((_page < 0) || (_page == 4))
+    _config = _pwmFreq = -1; // May have changed these, re-read when needed
+  return i2cWrite(buf, len);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set (or clear) a sink that receives a record of every I2C
+            transaction this object makes: capture to RAM, to a Print
+            stream (Serial, SD file), a register model, or a bus timing
+            model. Costs nothing but a pointer check when not set.
+    @param  sink  Pointer to Adafruit_IS31FL3741_TraceSink subclass, or
+                  NULL to stop tracing.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741::setTrace(Adafruit_IS31FL3741_TraceSink *sink) {
+  _trace = sink;
+}
+
 /**************************************************************************/
 /*!
     @brief    Set either the PWM or scaling level for a single LED; used by
@@ -206,7 +442,7 @@ bool Adafruit_IS31FL3741::setLEDvalue(uint8_t first_page, uint16_t lednum,
       cmd[0] = (uint8_t)(lednum - 180);
       selectPage(first_page + 1);
     }
-    return _i2c_dev->write(cmd, 2);
+    return i2cWrite(cmd, 2);
   }
   return false;
 }
@@ -240,7 +476,7 @@ bool Adafruit_IS31FL3741::fillTwoPages(uint8_t first_page, uint8_t value) {
     while (page_bytes) { // While there's data to write for page...
       uint8_t bytesThisPass = min((int)page_bytes, 31);
       buf[0] = addr;
-      if (!_i2c_dev->write(buf, bytesThisPass + 1)) // +1 for addr
+      if (!i2cWrite(buf, bytesThisPass + 1)) // +1 for addr
         return false;
       page_bytes -= bytesThisPass;
       addr += bytesThisPass;
@@ -251,6 +487,77 @@ bool Adafruit_IS31FL3741::fillTwoPages(uint8_t first_page, uint8_t value) {
   return true;
 }
 
+/**************************************************************************/
+/*!
+    @brief    Write two pages of IS31FL3741 registers (PWM or scaling) from
+              data generated a chunk at a time by a callback, so no full
+              351-byte copy is needed; used by writeScaling(),
+              setWhiteBalance() and mirroring, not directly.
+    @param    first_page  First of two successive pages to write; usually
+                          0 or 2.
+    @param    buf         Scratch buffer of at least max + 1 bytes.
+    @param    max         Most LED bytes per I2C write, e.g. 31 for a
+                          32-byte buffer (see notes in fillTwoPages()).
+    @param    func        Function filling in each chunk's LED bytes.
+    @param    arg         Passed through to func.
+    @returns  true if I2C transfers completed successfully, false on error.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741::writeTwoPages(uint8_t first_page, uint8_t *buf,
+                                        uint8_t max, IS3741_chunkFunc func,
+                                        void *arg) {
+  uint16_t start = 0; // LED index of current write, across both pages
+  for (uint8_t page = 0; page < 2; page++) {
+    uint16_t end = page ? 351 : 180; // First page is 180 bytes, then 171
+    selectPage(first_page + page);
+    while (start < end) {
+      uint8_t len = min((int)(end - start), (int)max);
+      buf[0] = page ? (start - 180) : start; // Register address
+      func(&buf[1], start, len, arg);
+      if (!i2cWrite(buf, len + 1)) // +1 for addr
+        return false;
+      start += len;
+    }
+  }
+  return true;
+}
+
+// writeTwoPages() callbacks copying a chunk from a 351-byte table in RAM
+// or PROGMEM, as passed in arg.
+static void _IS31copyChunk(uint8_t *data, uint16_t start, uint8_t len,
+                           void *arg) {
+  memcpy(data, &((const uint8_t *)arg)[start], len);
+}
+
+static void _IS31copyChunk_P(uint8_t *data, uint16_t start, uint8_t len,
+                             void *arg) {
+  const uint8_t *table = (const uint8_t *)arg;
+  for (uint8_t i = 0; i < len; i++)
+    data[i] = pgm_read_byte(&table[start + i]);
+}
+
+// setWhiteBalance() settings, passed through writeTwoPages() to the
+// balanceChunk() callbacks.
+typedef struct {
+  Adafruit_IS31FL3741_colorGFX_buffered *display; // Object being balanced
+  uint32_t balance;                               // 0xRRGGBB gains
+  const uint8_t *scales;                          // Calibration, or NULL
+  bool progmem;                                   // If set, scales in flash
+} _IS31balance;
+
+// Calibration value for one LED from setWhiteBalance() settings, 255 if none.
+static uint8_t _IS31calibration(const _IS31balance *b, uint16_t led) {
+  if (!b->scales)
+    return 255;
+  return b->progmem ? pgm_read_byte(&b->scales[led]) : b->scales[led];
+}
+
+// Apply red (c=0), green (1) or blue (2) gain from 0xRRGGBB to a value.
+static uint8_t _IS31applyGain(uint8_t value, uint32_t balance, uint8_t c) {
+  uint16_t gain = ((balance >> (16 - c * 8)) & 0xFF) + 1;
+  return (value * gain) >> 8;
+}
+
 /**************************************************************************/
 /*!
     @brief    Set the scaling level for a single LED.
@@ -279,6 +586,28 @@ bool Adafruit_IS31FL3741::setLEDscaling(uint8_t scale) {
   return fillTwoPages(2, scale); // Fill pages 2 & 3 with value
 }
 
+/**************************************************************************/
+/*!
+    @brief    Set the scaling level for every LED from a table, e.g. to
+              even out LED-to-LED brightness differences on a particular
+              panel, measured once and stored in flash (or EEPROM, copied
+              to RAM). Scaling is applied by the chip to every PWM value
+              that follows, so correction costs nothing at run time. Sent
+              in bulk, same as setLEDscaling(uint8_t). Chip reset (incl.
+              begin()) clears it, so call after begin().
+    @param    scales   Pointer to 351 scaling values, 0-255, indexed same
+                       as setLEDscaling(lednum, scale) and getBuffer().
+    @param    progmem  If true, table is in PROGMEM. Default is false (RAM).
+    @returns  true if I2C transfers completed successfully, false on error.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741::writeScaling(const uint8_t *scales, bool progmem) {
+  uint8_t buf[32]; // See notes in fillTwoPages()
+  return writeTwoPages(2, buf, sizeof buf - 1,
+                       progmem ? _IS31copyChunk_P : _IS31copyChunk,
+                       (void *)scales);
+}
+
 /**************************************************************************/
 /*!
     @brief    Set the PWM level for a single LED.
@@ -308,6 +637,51 @@ bool Adafruit_IS31FL3741::fill(uint8_t fillpwm) {
   return fillTwoPages(0, fillpwm); // Fill pages 0 & 1 with value
 }
 
+/**************************************************************************/
+/*!
+    @brief  Push a full frame of LED PWM data from RAM to device. This is
+            the guts of the buffered class' show(), here in the base class
+            so frames can come from other places too (e.g. triple
+            buffering).
+    @param  buf  Pointer to 352 bytes of LED data, same layout as the
+                 buffered class' ledbuf: one spare leading byte (used
+                 during transfer, contents preserved) and then 351 LEDs.
+    @note   This looks a lot like fillTwoPages(), but works differently
+            and they are not interchangeable or refactorable into a single
+            function. This relies on the spare byte in the LED buffer and
+            does some temporary element swaps to make larger transfers if
+            the host device allows. Really, don't.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741::writeBuffer(uint8_t *buf) {
+  uint8_t *ptr = buf;
+  uint8_t chunk = _i2c_dev->maxBufferSize() - 1;
+
+  uint8_t page_bytes = 180; // First page is 180 bytes of stuff
+  for (uint8_t page = 0; page < 2; page++) {
+    selectPage(page);
+    uint8_t addr = 0;    // Writes always start at reg 0 within page
+    while (page_bytes) { // While there's data to write for page...
+      uint8_t bytesThisPass = min(page_bytes, chunk);
+      // To avoid needing an extra I2C write buffer here (whose size may
+      // vary by architecture, not knowable at compile-time), save the
+      // ledbuf value at ptr, overwrite with the current register address,
+      // write straight from ledbuf and then restore the saved value.
+      // This is why there's an extra leading byte used in ledbuf.
+      // All the LED-setting functions use getBuffer(), which returns
+      // a pointer to the first LED at position #1, not #0.
+      uint8_t save = *ptr;
+      *ptr = addr;
+      i2cWrite(ptr, bytesThisPass + 1); // +1 for addr
+      *ptr = save;
+      page_bytes -= bytesThisPass;
+      ptr += bytesThisPass;
+      addr += bytesThisPass;
+    }
+    page_bytes = 171; // Subsequent page is smaller
+  }
+}
+
 /*!
   @brief   Convert hue, saturation and value into a packed 32-bit RGB color
            that can be passed to setPixelColor() or Color565(). Swiped
@@ -434,6 +808,41 @@ uint32_t Adafruit_IS31FL3741::gamma32(uint32_t x) {
   return x; // Packed 32-bit return
 }
 
+// Quarter-wave sine table for sin16(), 65 entries (0 to 90 degrees
+// inclusive) in Q15 format. Values between entries are linearly
+// interpolated, which is plenty for LEDs. To regenerate, in Python:
+// print([round(32767 * math.sin(i * math.pi / 128)) for i in range(65)])
+static const uint16_t PROGMEM _IS31SineTable[65] = {
+    0,     804,   1608,  2410,  3212,  4011,  4808,  5602,  6393,  7179,
+    7962,  8739,  9512,  10278, 11039, 11793, 12539, 13279, 14010, 14732,
+    15446, 16151, 16846, 17530, 18204, 18868, 19519, 20159, 20787, 21403,
+    22005, 22594, 23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+    27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956, 30273, 30571,
+    30852, 31113, 31356, 31580, 31785, 31971, 32137, 32285, 32412, 32521,
+    32609, 32678, 32728, 32757, 32767};
+
+/**************************************************************************/
+/*!
+  @brief   Fixed-point sine function, so that rotating/waving effects don't
+           need floating-point math (slow on many microcontrollers).
+  @param   angle  0 to 65535 for one full turn (i.e. 16384 = 90 degrees).
+                  Like ColorHSV() hues, this can "roll over" in either
+                  direction to make continuous motion easy.
+  @return  Sine of angle, -32767 to +32767 (i.e. Q15 fixed-point).
+*/
+/**************************************************************************/
+int16_t Adafruit_IS31FL3741::sin16(uint16_t angle) {
+  uint16_t idx = angle & 0x3FFF; // Position within quadrant, 14 bits
+  if (angle & 0x4000)            // 2nd & 4th quadrants run backwards
+    idx = 0x4000 - idx;          // (yields 1 to 16384)
+  uint8_t i = idx >> 8, frac = idx & 0xFF;
+  int32_t s = pgm_read_word(&_IS31SineTable[i]);
+  if (frac) { // Interpolate toward next entry (never past end if frac)
+    s += ((int32_t)pgm_read_word(&_IS31SineTable[i + 1]) - s) * frac >> 8;
+  }
+  return (angle & 0x8000) ? -s : s; // 3rd & 4th quadrants are negative
+}
+
 // IS31FL3741 (BUFFERED) ---------------------------------------------------
 // A few functions in the base glass get overloaded here, plus addition of
 // buffered-specific show() function.
@@ -465,44 +874,397 @@ bool Adafruit_IS31FL3741_buffered::begin(uint8_t addr, TwoWire *theWire) {
 
 /**************************************************************************/
 /*!
-    @brief  Push buffered LED data from RAM to device.
-    @note   This looks a lot like the base class' fillTwoPages() function,
-            but works differently and they are not interchangeable or
-            refactorable into a single function. This relies on the LED
-            buffer that's part of the Adafruit_IS31FL3741_buffered object
-            and does some temporary element swaps to make larger transfers
-            if the host device allows. Really, don't.
+    @brief  Push buffered LED data from RAM to device. Normally this is
+            just writeBuffer(), but once interrupt-safe mode is enabled
+            (see setISRSafe()), the transfer is made in 16-byte blocks
+            through a small stack buffer. Each block is copied under a
+            sequence count so an interrupt can't tear it, and any blocks
+            changed by an interrupt while the transfer was in progress are
+            re-sent afterward (up to a few passes; anything still changing
+            beyond that goes out with the next show()). Interrupts are
+            only disabled for a moment between passes, never for the
+            whole transfer.
 */
 /**************************************************************************/
 void Adafruit_IS31FL3741_buffered::show(void) {
-  uint8_t *ptr = ledbuf;
-  uint8_t chunk = _i2c_dev->maxBufferSize() - 1;
+  if (!_isrSafe) {
+    writeBuffer(ledbuf);
+    return;
+  }
+
+  noInterrupts();
+  _dirty = 0;
+  interrupts();
+  uint32_t mask = 0x7FFFFF; // First pass sends all 23 blocks
+  for (uint8_t pass = 0; mask && (pass < 4); pass++) {
+    writeBlocks(mask);
+    noInterrupts();
+    mask = _dirty; // Blocks an ISR touched during that pass
+    _dirty = 0;
+    interrupts();
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Enable or disable interrupt-safe show(). This is enabled
+            automatically by the first setLEDsFromISR() call (or
+            functions that use it), but enabling it in setup() also
+            covers the first transfer that might overlap an interrupt.
+            Costs a little extra I2C overhead vs. the normal show().
+    @param  on  true to enable, false to return to normal show().
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_buffered::setISRSafe(bool on) { _isrSafe = on; }
+
+/**************************************************************************/
+/*!
+    @brief  Set some number of LED buffer elements from an interrupt
+            handler (e.g. a timer driving ring indicators) while the main
+            loop draws and calls show(). The whole set of values is seen
+            by show() together or not at all, so e.g. the R, G and B of
+            one pixel won't be torn across frames. No immediate effect on
+            LEDs; the next (or current) show() picks up the change. Meant
+            for interrupts on the same core as show(); this is not a
+            lock for two cores both writing.
+    @param  idx    Array of indices into getBuffer(), 0-350. Out-of-range
+                   indices are skipped.
+    @param  value  Array of PWM values, 0-255, same count as idx.
+    @param  n      Number of elements in each array.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_buffered::setLEDsFromISR(const uint16_t *idx,
+                                                  const uint8_t *value,
+                                                  uint8_t n) {
+  uint32_t mask = 0;
+  _isrSeq = _isrSeq + 1; // Odd = write in progress
+  _IS31_MEMORY_BARRIER();
+  while (n--) {
+    uint16_t i = *idx++;
+    if (i < 351) {
+      ledbuf[1 + i] = *value;
+      // 16-byte blocks, each page starting a new block (0-11, 12-22)
+      mask |= (uint32_t)1 << ((i < 180) ? (i >> 4) : (12 + ((i - 180) >> 4)));
+    }
+    value++;
+  }
+  _IS31_MEMORY_BARRIER();
+  _isrSeq = _isrSeq + 1; // Even = done
+  _dirty = _dirty | mask;
+  _isrSafe = true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Send selected 16-byte blocks of the LED buffer to the device,
+            for interrupt-safe show() and Adafruit_IS31FL3741_DeltaShow.
+            Adjacent blocks are merged into one I2C write when the
+            interface's buffer size allows. Unlike
+            writeBuffer(), this copies through a small stack buffer rather
+            than poking the register address into ledbuf, as the latter
+            could restore a stale byte over one an interrupt just set.
+    @param  mask  Bit mask of blocks to send: bits 0-11 are page 0 (180
+                  bytes), bits 12-22 are page 1 (171 bytes).
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_buffered::writeBlocks(uint32_t mask) {
+  uint8_t buf[1 + 16 * 4]; // Register address + up to 4 blocks
+  uint8_t maxBlocks = (_i2c_dev->maxBufferSize() - 1) / 16;
+  if (maxBlocks > 4)
+    maxBlocks = 4;
 
-  uint8_t page_bytes = 180; // First page is 180 bytes of stuff
   for (uint8_t page = 0; page < 2; page++) {
-    selectPage(page);
-    uint8_t addr = 0;    // Writes always start at reg 0 within page
-    while (page_bytes) { // While there's data to write for page...
-      uint8_t bytesThisPass = min(page_bytes, chunk);
-      // To avoid needing an extra I2C write buffer here (whose size may
-      // vary by architecture, not knowable at compile-time), save the
-      // ledbuf value at ptr, overwrite with the current register address,
-      // write straight from ledbuf and then restore the saved value.
-      // This is why there's an extra leading byte used in ledbuf.
-      // All the LED-setting functions use getBuffer(), which returns
-      // a pointer to the first LED at position #1, not #0.
-      uint8_t save = *ptr;
-      *ptr = addr;
-      _i2c_dev->write(ptr, bytesThisPass + 1); // +1 for addr
-      *ptr = save;
-      page_bytes -= bytesThisPass;
-      ptr += bytesThisPass;
-      addr += bytesThisPass;
+    uint8_t first = page ? 12 : 0;  // First block # in page
+    uint8_t last = page ? 23 : 12;  // Last block # in page, +1
+    uint16_t base = page ? 180 : 0; // Page start in ledbuf
+    uint8_t page_bytes = page ? 171 : 180;
+    bool selected = false;
+    for (uint8_t b = first; b < last;) {
+      if (!(mask & ((uint32_t)1 << b))) {
+        b++;
+        continue;
+      }
+      uint8_t n = 1; // Merge any adjacent blocks
+      while (((b + n) < last) && (n < maxBlocks) &&
+             (mask & ((uint32_t)1 << (b + n))))
+        n++;
+      uint8_t addr = (b - first) * 16;
+      uint8_t len = n * 16;
+      if (len > (page_bytes - addr))
+        len = page_bytes - addr;
+      if (!selected) { // Only change page if something to write there
+        selectPage(page);
+        selected = true;
+      }
+      uint8_t seq;
+      do { // Retry copy if an ISR wrote anything meanwhile
+        while ((seq = _isrSeq) & 1)
+          ; // Writer active (only possible from another core)
+        _IS31_MEMORY_BARRIER();
+        memcpy(&buf[1], &ledbuf[1 + base + addr], len);
+        _IS31_MEMORY_BARRIER();
+      } while (seq != _isrSeq);
+      buf[0] = addr;
+      i2cWrite(buf, len + 1);
+      b += n;
     }
-    page_bytes = 171; // Subsequent page is smaller
   }
 }
 
+// Bulk buffer kernels for dim(), blend() and drawFrame(). Where the
+// compiler targets SSE2 or NEON (e.g. Linux hosts driving many panels)
+// these do 16 bytes (or 8 pixels) per step, on other 32-bit chips 4 bytes
+// per word (two 16-bit lanes for even bytes, two for odd), and on AVR one
+// byte at a time, where 32-bit multiplies cost more than they save. On x86
+// built with GCC or clang, an AVX2 version doing twice as much per step is
+// used first if the CPU has it (checked once, at run time), since host
+// builds usually target plain SSE2. The leftover bytes always go through
+// the plain loop at the end, and all methods give identical results: every
+// product fits in 16 bits, so no lane carries into the next.
+// Gamma (applyGamma(), drawFrame()) stays a table lookup everywhere; a
+// 256-entry byte table has no vector form in SSE2, AVX2 or 32-bit NEON.
+
+#if defined(_IS31_AVX2_)
+// true if CPU supports AVX2. Asked once, then remembered.
+static bool _IS31hasAVX2(void) {
+  static int8_t has = -1;
+  if (has < 0)
+    has = __builtin_cpu_supports("avx2") ? 1 : 0;
+  return has;
+}
+
+// AVX2 versions of the kernels below. Each does as many whole 32-byte
+// (or 16-pixel) steps as fit, returning the count done; caller finishes.
+_IS31_AVX2_ static uint16_t _IS31dimAVX2(uint8_t *buf, uint16_t len,
+                                         uint16_t w) {
+  const __m256i zero = _mm256_setzero_si256(), mul = _mm256_set1_epi16(w);
+  uint16_t i = 0;
+  for (; (i + 32) <= len; i += 32) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)&buf[i]);
+    __m256i lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(v, zero), mul);
+    __m256i hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(v, zero), mul);
+    v = _mm256_packus_epi16(_mm256_srli_epi16(lo, 8),
+                            _mm256_srli_epi16(hi, 8));
+    _mm256_storeu_si256((__m256i *)&buf[i], v);
+  }
+  return i;
+}
+
+_IS31_AVX2_ static uint16_t _IS31blendAVX2(uint8_t *dst, const uint8_t *src,
+                                           uint16_t len, uint16_t w) {
+  const __m256i zero = _mm256_setzero_si256(), mb = _mm256_set1_epi16(w),
+                ma = _mm256_set1_epi16(256 - w);
+  uint16_t i = 0;
+  for (; (i + 32) <= len; i += 32) {
+    __m256i a = _mm256_loadu_si256((const __m256i *)&dst[i]);
+    __m256i b = _mm256_loadu_si256((const __m256i *)&src[i]);
+    __m256i lo = _mm256_add_epi16(
+        _mm256_mullo_epi16(_mm256_unpacklo_epi8(a, zero), ma),
+        _mm256_mullo_epi16(_mm256_unpacklo_epi8(b, zero), mb));
+    __m256i hi = _mm256_add_epi16(
+        _mm256_mullo_epi16(_mm256_unpackhi_epi8(a, zero), ma),
+        _mm256_mullo_epi16(_mm256_unpackhi_epi8(b, zero), mb));
+    a = _mm256_packus_epi16(_mm256_srli_epi16(lo, 8),
+                            _mm256_srli_epi16(hi, 8));
+    _mm256_storeu_si256((__m256i *)&dst[i], a);
+  }
+  return i;
+}
+
+_IS31_AVX2_ static uint16_t _IS31expandAVX2(const uint16_t *src, uint8_t *r,
+                                            uint8_t *g, uint8_t *b,
+                                            uint16_t n) {
+  const __m256i f8 = _mm256_set1_epi16(0xF8), fc = _mm256_set1_epi16(0xFC),
+                m3 = _mm256_set1_epi16(3), m7 = _mm256_set1_epi16(7);
+  uint16_t i = 0;
+  for (; (i + 16) <= n; i += 16) {
+    __m256i c = _mm256_loadu_si256((const __m256i *)&src[i]);
+    __m256i rr = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi16(c, 8), f8),
+                                 _mm256_srli_epi16(c, 13));
+    __m256i gg = _mm256_or_si256(
+        _mm256_and_si256(_mm256_srli_epi16(c, 3), fc),
+        _mm256_and_si256(_mm256_srli_epi16(c, 9), m3));
+    __m256i bb = _mm256_or_si256(_mm256_and_si256(_mm256_slli_epi16(c, 3), f8),
+                                 _mm256_and_si256(_mm256_srli_epi16(c, 2), m7));
+    // Packing works within 128-bit halves, permute puts pixels in order
+    __m256i rg = _mm256_permute4x64_epi64(_mm256_packus_epi16(rr, gg), 0xD8);
+    bb = _mm256_permute4x64_epi64(_mm256_packus_epi16(bb, bb), 0xD8);
+    _mm_storeu_si128((__m128i *)&r[i], _mm256_castsi256_si128(rg));
+    _mm_storeu_si128((__m128i *)&g[i], _mm256_extracti128_si256(rg, 1));
+    _mm_storeu_si128((__m128i *)&b[i], _mm256_castsi256_si128(bb));
+  }
+  return i;
+}
+#endif // _IS31_AVX2_
+
+// Scale len bytes by w/256 (w = 0 to 256): buf[i] = (buf[i] * w) >> 8.
+static void _IS31dim(uint8_t *buf, uint16_t len, uint16_t w) {
+  uint16_t i = 0;
+#if defined(_IS31_AVX2_)
+  if (_IS31hasAVX2())
+    i = _IS31dimAVX2(buf, len, w);
+#endif
+#if defined(__SSE2__)
+  const __m128i zero = _mm_setzero_si128(), mul = _mm_set1_epi16(w);
+  for (; (i + 16) <= len; i += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *)&buf[i]);
+    __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(v, zero), mul);
+    __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(v, zero), mul);
+    v = _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+    _mm_storeu_si128((__m128i *)&buf[i], v);
+  }
+#elif defined(__ARM_NEON)
+  for (; (i + 16) <= len; i += 16) {
+    uint8x16_t v = vld1q_u8(&buf[i]);
+    uint16x8_t lo = vmulq_n_u16(vmovl_u8(vget_low_u8(v)), w);
+    uint16x8_t hi = vmulq_n_u16(vmovl_u8(vget_high_u8(v)), w);
+    vst1q_u8(&buf[i], vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8)));
+  }
+#elif !defined(__AVR__)
+  for (; (i + 4) <= len; i += 4) {
+    uint32_t v;
+    memcpy(&v, &buf[i], 4); // ledbuf is not word-aligned
+    v = ((((v & 0x00FF00FF) * w) >> 8) & 0x00FF00FF) |
+        ((((v >> 8) & 0x00FF00FF) * w) & 0xFF00FF00);
+    memcpy(&buf[i], &v, 4);
+  }
+#endif
+  for (; i < len; i++)
+    buf[i] = (buf[i] * w) >> 8;
+}
+
+// Mix len bytes of src into dst by w/256 (w = 0 to 256):
+// dst[i] = (dst[i] * (256 - w) + src[i] * w) >> 8.
+static void _IS31blend(uint8_t *dst, const uint8_t *src, uint16_t len,
+                       uint16_t w) {
+  uint16_t iw = 256 - w, i = 0;
+#if defined(_IS31_AVX2_)
+  if (_IS31hasAVX2())
+    i = _IS31blendAVX2(dst, src, len, w);
+#endif
+#if defined(__SSE2__)
+  const __m128i zero = _mm_setzero_si128(), mb = _mm_set1_epi16(w),
+                ma = _mm_set1_epi16(iw);
+  for (; (i + 16) <= len; i += 16) {
+    __m128i a = _mm_loadu_si128((const __m128i *)&dst[i]);
+    __m128i b = _mm_loadu_si128((const __m128i *)&src[i]);
+    __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), ma),
+                               _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), mb));
+    __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), ma),
+                               _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), mb));
+    a = _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+    _mm_storeu_si128((__m128i *)&dst[i], a);
+  }
+#elif defined(__ARM_NEON)
+  for (; (i + 16) <= len; i += 16) {
+    uint8x16_t a = vld1q_u8(&dst[i]), b = vld1q_u8(&src[i]);
+    uint16x8_t lo = vmlaq_n_u16(vmulq_n_u16(vmovl_u8(vget_low_u8(a)), iw),
+                                vmovl_u8(vget_low_u8(b)), w);
+    uint16x8_t hi = vmlaq_n_u16(vmulq_n_u16(vmovl_u8(vget_high_u8(a)), iw),
+                                vmovl_u8(vget_high_u8(b)), w);
+    vst1q_u8(&dst[i], vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8)));
+  }
+#elif !defined(__AVR__)
+  for (; (i + 4) <= len; i += 4) {
+    uint32_t a, b;
+    memcpy(&a, &dst[i], 4); // Neither buffer need be word-aligned
+    memcpy(&b, &src[i], 4);
+    a = (((((a & 0x00FF00FF) * iw) + ((b & 0x00FF00FF) * w)) >> 8) &
+         0x00FF00FF) |
+        (((((a >> 8) & 0x00FF00FF) * iw) + (((b >> 8) & 0x00FF00FF) * w)) &
+         0xFF00FF00);
+    memcpy(&dst[i], &a, 4);
+  }
+#endif
+  for (; i < len; i++)
+    dst[i] = (dst[i] * iw + src[i] * w) >> 8;
+}
+
+// Expand n RGB565 pixels to separate 8-bit red, green and blue arrays,
+// same as _IS31_EXPAND_ (top bits repeated into the low ones).
+static void _IS31expand565(const uint16_t *src, uint8_t *r, uint8_t *g,
+                           uint8_t *b, uint16_t n) {
+  uint16_t i = 0;
+#if defined(_IS31_AVX2_)
+  if (_IS31hasAVX2())
+    i = _IS31expandAVX2(src, r, g, b, n);
+#endif
+#if defined(__SSE2__)
+  const __m128i f8 = _mm_set1_epi16(0xF8), fc = _mm_set1_epi16(0xFC),
+                m3 = _mm_set1_epi16(3), m7 = _mm_set1_epi16(7);
+  for (; (i + 8) <= n; i += 8) {
+    __m128i c = _mm_loadu_si128((const __m128i *)&src[i]);
+    __m128i rr = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(c, 8), f8),
+                              _mm_srli_epi16(c, 13));
+    __m128i gg = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(c, 3), fc),
+                              _mm_and_si128(_mm_srli_epi16(c, 9), m3));
+    __m128i bb = _mm_or_si128(_mm_and_si128(_mm_slli_epi16(c, 3), f8),
+                              _mm_and_si128(_mm_srli_epi16(c, 2), m7));
+    __m128i rg = _mm_packus_epi16(rr, gg); // 8 red bytes, 8 green
+    _mm_storel_epi64((__m128i *)&r[i], rg);
+    _mm_storel_epi64((__m128i *)&g[i], _mm_srli_si128(rg, 8));
+    _mm_storel_epi64((__m128i *)&b[i], _mm_packus_epi16(bb, bb));
+  }
+#elif defined(__ARM_NEON)
+  const uint16x8_t f8 = vdupq_n_u16(0xF8), fc = vdupq_n_u16(0xFC),
+                   m3 = vdupq_n_u16(3), m7 = vdupq_n_u16(7);
+  for (; (i + 8) <= n; i += 8) {
+    uint16x8_t c = vld1q_u16(&src[i]);
+    vst1_u8(&r[i], vmovn_u16(vorrq_u16(vandq_u16(vshrq_n_u16(c, 8), f8),
+                                       vshrq_n_u16(c, 13))));
+    vst1_u8(&g[i], vmovn_u16(vorrq_u16(vandq_u16(vshrq_n_u16(c, 3), fc),
+                                       vandq_u16(vshrq_n_u16(c, 9), m3))));
+    vst1_u8(&b[i], vmovn_u16(vorrq_u16(vandq_u16(vshlq_n_u16(c, 3), f8),
+                                       vandq_u16(vshrq_n_u16(c, 2), m7))));
+  }
+#endif
+  for (; i < n; i++) {
+    uint16_t c = src[i];
+    r[i] = ((c >> 8) & 0xF8) | (c >> 13);
+    g[i] = ((c >> 3) & 0xFC) | ((c >> 9) & 0x03);
+    b[i] = ((c << 3) & 0xF8) | ((c >> 2) & 0x07);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Scale the brightness of every LED in the buffer, e.g. for
+            fade-outs or trails. No immediate effect on LEDs; must follow
+            up with show().
+    @param  level  Brightness, 0 (off) to 255 (unchanged).
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_buffered::dim(uint8_t level) {
+  _IS31dim(&ledbuf[1], 351, level + 1);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Crossfade the LED buffer toward another frame of the same
+            layout, e.g. another buffered object's getBuffer(). No
+            immediate effect on LEDs; must follow up with show().
+    @param  frame   Pointer to 351 bytes of LED data, as from getBuffer().
+    @param  amount  Mix, 0 (buffer unchanged) to 255 (copy of frame).
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_buffered::blend(const uint8_t *frame,
+                                         uint8_t amount) {
+  _IS31blend(&ledbuf[1], frame, 351, amount + (amount >> 7));
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gamma-correct every LED in the buffer in place, same curve as
+            gamma8(), so drawing can be done in linear brightness and
+            corrected once per frame. No immediate effect on LEDs; must
+            follow up with show().
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_buffered::applyGamma(void) {
+  for (uint16_t i = 1; i < 352; i++)
+    ledbuf[i] = gamma8(ledbuf[i]);
+}
+
 // INTERMEDIARY CLASSES FOR COLORS AND GFX ---------------------------------
 
 /**************************************************************************/
@@ -568,21 +1330,439 @@ void Adafruit_IS31FL3741_colorGFX_buffered::fill(uint16_t color) {
   }
 }
 
-// DEVICE-SPECIFIC SUBCLASSES ----------------------------------------------
-
-// LUMISSIL EVAL BOARD (DIRECT, UNBUFFERED) --------------------------------
-
 /**************************************************************************/
 /*!
-    @brief  Adafruit GFX low level accessor - sets an RGB pixel value,
-            handles rotation and pixel arrangement.
-    @param  x      The x position, starting with 0 for left-most side
-    @param  y      The y position, starting with 0 for top-most side
-    @param  color  16-bit RGB565 packed color (expands to 888 for LEDs).
+    @brief  Draw an RGB565 bitmap from PROGMEM through an affine transform
+            (rotation, scaling, shearing or any combination), for spinning
+            and zooming logos and such. All fixed-point integer math, with
+            the transform stepped incrementally across each scanline, so
+            it's fast even on chips without an FPU. Matrix pixels mapping
+            outside the bitmap are left untouched, so this can be drawn
+            over a background.
+    @param  bitmap  Pointer to RGB565 bitmap in PROGMEM, w*h pixels in
+                    row-major order (as used by GFX drawRGBBitmap()).
+    @param  w       Bitmap width in pixels.
+    @param  h       Bitmap height in pixels.
+    @param  xform   Pointer to transform mapping matrix (destination) pixels
+                    to bitmap (source) pixels, e.g. from setRotoZoom().
+    @param  smooth  If true, bilinear filter between the four nearest
+                    bitmap pixels, else nearest-neighbor. Default is false.
 */
 /**************************************************************************/
-void Adafruit_IS31FL3741_EVB::drawPixel(int16_t x, int16_t y, uint16_t color) {
-  if ((x >= 0) && (y >= 0) && (x < width()) && (y < height())) {
+void Adafruit_IS31FL3741_colorGFX_buffered::drawAffine(
+    const uint16_t *bitmap, int16_t w, int16_t h, const IS3741_affine *xform,
+    bool smooth) {
+  int32_t umax = (int32_t)w << 16, vmax = (int32_t)h << 16;
+  // Source position at center of first pixel in row. Stepping a full
+  // pixel thereafter keeps it centered.
+  int32_t u0 = xform->tx + ((xform->a + xform->b) >> 1);
+  int32_t v0 = xform->ty + ((xform->c + xform->d) >> 1);
+  for (int16_t y = 0; y < height(); y++) {
+    int32_t u = u0, v = v0;
+    for (int16_t x = 0; x < width(); x++) {
+      if ((u >= 0) && (v >= 0) && (u < umax) && (v < vmax)) {
+        if (smooth) {
+          // Bilinear filter works relative to bitmap pixel centers, so
+          // offset by half a pixel, then clip neighbors at bitmap edges.
+          int32_t us = u - 0x8000, vs = v - 0x8000;
+          int16_t bx = 0, by = 0, dy = 0;
+          uint8_t fx = 0, fy = 0, dx = 0;
+          if (us > 0) {
+            bx = us >> 16;
+            if (bx < (w - 1)) {
+              fx = us >> 8; // Fraction toward next pixel right
+              dx = 1;
+            }
+          }
+          if (vs > 0) {
+            by = vs >> 16;
+            if (by < (h - 1)) {
+              fy = vs >> 8; // Fraction toward next pixel down
+              dy = w;
+            }
+          }
+          const uint16_t *ptr = &bitmap[by * w + bx];
+          uint16_t c[4];
+          c[0] = pgm_read_word(ptr);
+          c[1] = pgm_read_word(ptr + dx);
+          c[2] = pgm_read_word(ptr + dy);
+          c[3] = pgm_read_word(ptr + dy + dx);
+          // Weights of the 4 pixels, 16-bit fraction (sum = 65536)
+          uint32_t wt[4];
+          wt[0] = (uint32_t)(256 - fx) * (256 - fy);
+          wt[1] = (uint32_t)fx * (256 - fy);
+          wt[2] = (uint32_t)(256 - fx) * fy;
+          wt[3] = (uint32_t)fx * fy;
+          uint32_t rsum = 0, gsum = 0, bsum = 0;
+          for (uint8_t i = 0; i < 4; i++) {
+            rsum += (c[i] >> 11) * wt[i];         // 5 bits red,
+            gsum += ((c[i] >> 5) & 0x3F) * wt[i]; // 6 bits green,
+            bsum += (c[i] & 0x1F) * wt[i];        // 5 bits blue
+          }
+          rsum = (rsum >> 5) & 0xF800; // Back to RGB565 positions
+          gsum = (gsum >> 11) & 0x07E0;
+          drawPixel(x, y, rsum | gsum | (bsum >> 16));
+        } else {
+          drawPixel(x, y, pgm_read_word(&bitmap[(v >> 16) * w + (u >> 16)]));
+        }
+      }
+      u += xform->a; // Step one pixel right in destination
+      v += xform->c;
+    }
+    u0 += xform->b; // Step one row down in destination
+    v0 += xform->d;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fill an IS3741_affine transform for drawAffine() to rotate and
+            zoom a bitmap around a given point. Fixed-point math except for
+            a couple of 64-bit ops, only done once per frame.
+    @param  xform  Pointer to IS3741_affine struct to fill.
+    @param  angle  Rotation, 0 to 65535 for one full turn (as in sin16()).
+    @param  zoom   Scale factor, 16.16 fixed-point (e.g. IS3741_FIXED(1.0)
+                   for 1:1, IS3741_FIXED(2.0) for double size). Values
+                   below 3 (about 1/21845) are treated as 3, as smaller
+                   steps overflow the transform.
+    @param  srcX   X center of rotation in bitmap, 16.16 fixed-point. Pixel
+                   edges are at integer positions, e.g. IS3741_FIXED(4.0)
+                   is the middle of an 8-pixel-wide bitmap.
+    @param  srcY   Y center of rotation in bitmap, 16.16 fixed-point.
+    @param  dstX   X position on matrix where srcX appears, 16.16 fixed-
+                   point (e.g. IS3741_FIXED(9.0) centers on 18 pixels).
+    @param  dstY   Y position on matrix where srcY appears, 16.16 fixed.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_colorGFX_buffered::setRotoZoom(
+    IS3741_affine *xform, uint16_t angle, int32_t zoom, int32_t srcX,
+    int32_t srcY, int32_t dstX, int32_t dstY) {
+  // Steps below come out to 2^32 / zoom, which only fits in int32_t if
+  // zoom is 3 or more (bitmap will be microscopic either way).
+  if (zoom < 3)
+    zoom = 3;
+  // Matrix-to-bitmap steps are the inverse rotation divided by zoom.
+  // sin16() & cos16() are Q15 (max 32767, not 32768), so divide that out
+  // too, else 1:1 steps come up a hair short and skip pixels.
+  int64_t div = (int64_t)zoom * 32767;
+  int32_t cs = ((int64_t)cos16(angle) * 0x100000000LL) / div;
+  int32_t sn = ((int64_t)sin16(angle) * 0x100000000LL) / div;
+  xform->a = cs;
+  xform->b = sn;
+  xform->c = -sn;
+  xform->d = cs;
+  // Then offset so that dstX,dstY lands on srcX,srcY
+  int64_t dx = (int64_t)cs * dstX + (int64_t)sn * dstY;
+  int64_t dy = (int64_t)cs * dstY - (int64_t)sn * dstX;
+  xform->tx = srcX - (int32_t)(dx >> 16);
+  xform->ty = srcY - (int32_t)(dy >> 16);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Look up where one pixel's red, green and blue elements reside
+            in the LED buffer, handling rotation, pixel arrangement and
+            color order same as drawPixel(). For code (such as effects)
+            that writes RGB888 values straight into getBuffer() instead
+            of going through drawPixel() and RGB565 colors.
+    @param  x    The x position, starting with 0 for left-most side.
+    @param  y    The y position, starting with 0 for top-most side.
+    @param  idx  Array of 3 uint16_t to receive the red, green and blue
+                 indices (in that order) into getBuffer().
+    @returns bool  true if pixel is on the matrix and has an LED there,
+                   false if off matrix or a hole (e.g. EyeLights corners).
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741_colorGFX_buffered::getLEDIndices(int16_t x, int16_t y,
+                                                          uint16_t *idx) {
+  if ((x >= 0) && (y >= 0) && (x < width()) && (y < height())) {
+    _IS31_ROTATE_(x, y); // Handle GFX-style soft rotation
+    return mapPixel(x, y, idx);
+  }
+  return false;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set one pixel from an interrupt handler. Same as drawPixel(),
+            but all three color elements are updated together and show()
+            is told, so a transfer in progress can't send a torn color.
+            See Adafruit_IS31FL3741_buffered::setLEDsFromISR().
+    @param  x      The x position, starting with 0 for left-most side.
+    @param  y      The y position, starting with 0 for top-most side.
+    @param  color  16-bit RGB565 packed color (expands to 888 for LEDs).
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_colorGFX_buffered::drawPixelFromISR(int16_t x,
+                                                             int16_t y,
+                                                             uint16_t color) {
+  uint16_t idx[3];
+  if (getLEDIndices(x, y, idx)) {
+    _IS31_EXPAND_(color, r, g, b);
+    uint8_t value[3] = {r, g, b};
+    setLEDsFromISR(idx, value, 3);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Soften the whole matrix with a 3x3 blur (1-2-1 weights in each
+            direction), done as separate row and column passes in place
+            in the LED buffer. Integer math only and no extra buffer, just
+            a few values carried along each line. Holes in the matrix (e.g.
+            EyeLights corners) are skipped, neighbors treat them like the
+            matrix edge. No immediate effect on LEDs; must follow up with
+            show().
+    @param  amount  Blend between original (0) and fully blurred (255).
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_colorGFX_buffered::blur(uint8_t amount) {
+  // Kernel is symmetric, so rotation doesn't matter; work in native
+  // (unrotated) coordinates and skip the per-pixel rotate.
+  for (int16_t y = 0; y < HEIGHT; y++)
+    blurLine(0, y, 1, 0, WIDTH, amount + 1);
+  for (int16_t x = 0; x < WIDTH; x++)
+    blurLine(x, 0, 0, 1, HEIGHT, amount + 1);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Blur one row or column of pixels in place, for blur().
+    @param  x       Native (unrotated) X of first pixel.
+    @param  y       Native (unrotated) Y of first pixel.
+    @param  dx      X step between pixels (0 or 1).
+    @param  dy      Y step between pixels (0 or 1).
+    @param  n       Number of pixels in line.
+    @param  amount  Blend factor, 1 to 256.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_colorGFX_buffered::blurLine(int16_t x, int16_t y,
+                                                     int16_t dx, int16_t dy,
+                                                     int16_t n,
+                                                     uint16_t amount) {
+  uint8_t *buf = getBuffer();
+  uint16_t cur[3], next[3];
+  uint8_t prev[3]; // Previous pixel's value BEFORE blurring
+  bool curOk = mapPixel(x, y, cur), nextOk, havePrev = false;
+  for (int16_t i = 0; i < n; i++) {
+    x += dx;
+    y += dy;
+    nextOk = (i < (n - 1)) && mapPixel(x, y, next);
+    if (curOk) {
+      for (uint8_t c = 0; c < 3; c++) {
+        uint8_t v = buf[cur[c]];
+        uint8_t l = havePrev ? prev[c] : v; // Edges & holes use self
+        uint8_t r = nextOk ? buf[next[c]] : v;
+        uint8_t blurred = ((uint16_t)l + v * 2 + r + 2) >> 2;
+        prev[c] = v;
+        buf[cur[c]] = ((uint16_t)v * (256 - amount) + blurred * amount) >> 8;
+      }
+    }
+    havePrev = curOk;
+    memcpy(cur, next, sizeof cur);
+    curOk = nextOk;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Get the part of one pixel's R,G,B exceeding a threshold, for
+            bloom(). Holes are black.
+    @param  x          Native (unrotated) X, may be off matrix.
+    @param  y          Native (unrotated) Y, may be off matrix.
+    @param  threshold  Level subtracted from each of R,G,B.
+    @param  rgb        Array of 3 uint8_t to receive result.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_colorGFX_buffered::brightPass(int16_t x, int16_t y,
+                                                       uint8_t threshold,
+                                                       uint8_t *rgb) {
+  uint16_t idx[3];
+  if ((x >= 0) && (y >= 0) && (x < WIDTH) && (y < HEIGHT) &&
+      mapPixel(x, y, idx)) {
+    uint8_t *buf = getBuffer();
+    for (uint8_t c = 0; c < 3; c++) {
+      uint8_t v = buf[idx[c]];
+      rgb[c] = (v > threshold) ? v - threshold : 0;
+    }
+  } else {
+    rgb[0] = rgb[1] = rgb[2] = 0;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Add a glow around bright pixels: the part of each pixel above
+            a threshold is blurred (3x3, 1-2-1 weights) and added back
+            over the matrix, clipping at full brightness. Done in place
+            in the LED buffer in a single top-to-bottom pass, integer math
+            only, using one row of scratch memory (on the stack). Holes in
+            the matrix (e.g. EyeLights corners) neither glow nor receive
+            glow. No immediate effect on LEDs; must follow up with show().
+            Matrices wider than 18 pixels (native, unrotated) are not
+            supported and left unchanged.
+    @param  threshold  Brightness (0-255, per R,G,B) above which pixels
+                       start to glow.
+    @param  strength   Intensity of glow, 0 (none) to 255. 64 adds the
+                       blurred excess as-is, higher values exaggerate it.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_colorGFX_buffered::bloom(uint8_t threshold,
+                                                  uint8_t strength) {
+  // Kernel is symmetric, so work in native (unrotated) coordinates.
+  // Widest native matrix in this library is 18 pixels (EyeLights); the
+  // scratch row is sized for that, so wider subclasses are left as-is.
+  uint16_t above[18 * 3]; // Row above, horizontal pass (4X scale)
+  if (WIDTH * 3 > (int16_t)(sizeof above / sizeof above[0]))
+    return;
+  memset(above, 0, sizeof above);
+  uint8_t *buf = getBuffer();
+  for (int16_t y = 0; y < HEIGHT; y++) {
+    // Bright parts of left, center & right pixels in this row and next.
+    // Pixels right of (and below) the current one haven't been written
+    // yet, so these are all original values.
+    uint8_t l[3] = {0, 0, 0}, c[3], r[3], nl[3] = {0, 0, 0}, nc[3], nr[3];
+    brightPass(0, y, threshold, c);
+    brightPass(0, y + 1, threshold, nc);
+    for (int16_t x = 0; x < WIDTH; x++) {
+      brightPass(x + 1, y, threshold, r);
+      brightPass(x + 1, y + 1, threshold, nr);
+      uint16_t idx[3];
+      bool ok = mapPixel(x, y, idx);
+      for (uint8_t i = 0; i < 3; i++) {
+        uint16_t h = l[i] + c[i] * 2 + r[i];     // This row, 4X
+        uint16_t hn = nl[i] + nc[i] * 2 + nr[i]; // Next row, 4X
+        if (ok) {
+          uint32_t glow = above[x * 3 + i] + h * 2 + hn; // 16X
+          uint32_t v = buf[idx[i]] + ((glow * strength) >> 10);
+          buf[idx[i]] = (v > 255) ? 255 : v;
+        }
+        above[x * 3 + i] = h;
+        l[i] = c[i];
+        c[i] = r[i];
+        nl[i] = nc[i];
+        nc[i] = nr[i];
+      }
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Copy a whole RGB565 frame into the LED buffer in one pass, e.g.
+            from a GFXcanvas16 of the same size that was drawn to instead
+            (canvas->getBuffer()). Color expansion to RGB888 runs in bulk
+            (SIMD where available, see _IS31expand565()), then gamma, if
+            requested, and each pixel's color order and position in the
+            buffer are applied as it's stored. Handles rotation, same as
+            drawPixel(). No immediate effect on LEDs; must follow up with
+            show().
+    @param  frame  Pointer to width() * height() RGB565 pixels, row-major
+                   in the current rotation.
+    @param  gamma  If true, gamma-correct each color same as gamma8().
+                   Default is false.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_colorGFX_buffered::drawFrame(const uint16_t *frame,
+                                                      bool gamma) {
+  uint8_t *buf = getBuffer();
+  uint8_t rgb[3][16]; // Expanded colors for up to 16 pixels at a time
+  int16_t w = width(), h = height();
+  for (int16_t y = 0; y < h; y++) {
+    for (int16_t x = 0; x < w; x += 16) {
+      uint8_t n = min(w - x, 16);
+      _IS31expand565(&frame[y * w + x], rgb[0], rgb[1], rgb[2], n);
+      for (uint8_t i = 0; i < n; i++) {
+        uint16_t idx[3];
+        if (getLEDIndices(x + i, y, idx)) {
+          for (uint8_t c = 0; c < 3; c++)
+            buf[idx[c]] = gamma ? gamma8(rgb[c][i]) : rgb[c][i];
+        }
+      }
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief    Set the scaling level of every LED for white balance, with
+              optional per-LED calibration. Each LED's scaling becomes its
+              calibration value (or 255 if none) times the gain for its
+              color. Like writeScaling(), this is handled by the chip and
+              costs nothing at run time, and reset (incl. begin()) clears
+              it. Subclasses with LEDs outside the GFX matrix (EyeLights
+              rings) apply the gains to those too.
+    @param    balance  Red, green and blue gains packed as 0xRRGGBB, either
+                       one of the IS3741_WHITE_* presets or measured for a
+                       specific panel.
+    @param    scales   Pointer to 351 per-LED calibration values, indexed
+                       same as getBuffer(), or NULL (default) for none.
+    @param    progmem  If true, scales table is in PROGMEM. Default is
+                       false (RAM).
+    @returns  true if I2C transfers completed successfully, false on error.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741_colorGFX_buffered::setWhiteBalance(
+    uint32_t balance, const uint8_t *scales, bool progmem) {
+  _IS31balance b = {this, balance, scales, progmem};
+  uint8_t buf[32]; // See notes in fillTwoPages()
+  return writeTwoPages(2, buf, sizeof buf - 1, balanceChunk, &b);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fill one chunk of scaling registers for setWhiteBalance():
+            calibration values (or 255), then the color gains applied to
+            the elements of any matrix pixels that fall within the chunk.
+    @param  data   Chunk of scaling values to fill.
+    @param  start  LED index of data[0].
+    @param  len    Number of values in chunk.
+    @param  arg    Pointer to _IS31balance settings.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_colorGFX_buffered::balanceChunk(uint8_t *data,
+                                                         uint16_t start,
+                                                         uint8_t len,
+                                                         void *arg) {
+  const _IS31balance *b = (const _IS31balance *)arg;
+  Adafruit_IS31FL3741_colorGFX_buffered *gfx = b->display;
+  if (!b->scales) {
+    memset(data, 255, len);
+  } else if (b->progmem) {
+    _IS31copyChunk_P(data, start, len, (void *)b->scales);
+  } else {
+    _IS31copyChunk(data, start, len, (void *)b->scales);
+  }
+  // Unsigned math, so anything before start is also out of range
+  for (int16_t y = 0; y < gfx->HEIGHT; y++) {
+    for (int16_t x = 0; x < gfx->WIDTH; x++) {
+      uint16_t idx[3];
+      if (gfx->mapPixel(x, y, idx)) {
+        for (uint8_t c = 0; c < 3; c++) {
+          uint16_t i = idx[c] - start;
+          if (i < len)
+            data[i] = _IS31applyGain(data[i], b->balance, c);
+        }
+      }
+    }
+  }
+}
+
+// DEVICE-SPECIFIC SUBCLASSES ----------------------------------------------
+
+// LUMISSIL EVAL BOARD (DIRECT, UNBUFFERED) --------------------------------
+
+/**************************************************************************/
+/*!
+    @brief  Adafruit GFX low level accessor - sets an RGB pixel value,
+            handles rotation and pixel arrangement.
+    @param  x      The x position, starting with 0 for left-most side
+    @param  y      The y position, starting with 0 for top-most side
+    @param  color  16-bit RGB565 packed color (expands to 888 for LEDs).
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_EVB::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if ((x >= 0) && (y >= 0) && (x < width()) && (y < height())) {
     _IS31_ROTATE_(x, y);           // Handle GFX-style soft rotation
     _IS31_EXPAND_(color, r, g, b); // Expand GFX's RGB565 color to RGB888
 
@@ -617,23 +1797,34 @@ void Adafruit_IS31FL3741_EVB_buffered::drawPixel(int16_t x, int16_t y,
   if ((x >= 0) && (y >= 0) && (x < width()) && (y < height())) {
     _IS31_ROTATE_(x, y);           // Handle GFX-style soft rotation
     _IS31_EXPAND_(color, r, g, b); // Expand GFX's RGB565 color to RGB888
-
-    // Map x/y to device-specific pixel layout
-    uint16_t offset = ((y > 2) ? (x * 10 + 12 - y) : (92 + x * 3 - y)) * 3;
-
-    /*
-    Serial.print("("); Serial.print(x);
-    Serial.print(", "); Serial.print(y);
-    Serial.print(") -> "); Serial.println(offset);
-    */
-
-    uint8_t *ptr = &ledbuf[1 + offset];
-    ptr[rOffset] = r;
-    ptr[gOffset] = g;
-    ptr[bOffset] = b;
+    uint16_t idx[3];
+    Adafruit_IS31FL3741_EVB_buffered::mapPixel(x, y, idx);
+    uint8_t *buf = getBuffer();
+    buf[idx[0]] = r;
+    buf[idx[1]] = g;
+    buf[idx[2]] = b;
   }
 }
 
+/**************************************************************************/
+/*!
+    @brief  Map native (unrotated) pixel position to LED buffer indices.
+    @param  x    The x position, already clipped & rotated.
+    @param  y    The y position, already clipped & rotated.
+    @param  idx  Array of 3 uint16_t to receive R,G,B indices.
+    @returns bool  Always true, every pixel on this board has an LED.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741_EVB_buffered::mapPixel(int16_t x, int16_t y,
+                                                uint16_t *idx) {
+  // Map x/y to device-specific pixel layout
+  uint16_t offset = ((y > 2) ? (x * 10 + 12 - y) : (92 + x * 3 - y)) * 3;
+  idx[0] = offset + rOffset;
+  idx[1] = offset + gOffset;
+  idx[2] = offset + bOffset;
+  return true;
+}
+
 // STEMMA QT MATRIX (DIRECT) -----------------------------------------------
 
 /**************************************************************************/
@@ -694,34 +1885,43 @@ void Adafruit_IS31FL3741_QT_buffered::drawPixel(int16_t x, int16_t y,
   if ((x >= 0) && (y >= 0) && (x < width()) && (y < height())) {
     _IS31_ROTATE_(x, y);           // Handle GFX-style soft rotation
     _IS31_EXPAND_(color, r, g, b); // Expand GFX's RGB565 color to RGB888
+    uint16_t idx[3];
+    Adafruit_IS31FL3741_QT_buffered::mapPixel(x, y, idx);
+    uint8_t *buf = getBuffer();
+    buf[idx[0]] = r;
+    buf[idx[1]] = g;
+    buf[idx[2]] = b;
+  }
+}
 
-    /*
-    Serial.print("("); Serial.print(x);
-    Serial.print(", "); Serial.print(y);
-    Serial.print(") -> 0x");
-    */
-
-    // Remap the row (y)
-    static const uint8_t rowmap[] = {8, 5, 4, 3, 2, 1, 0, 7, 6};
-    y = rowmap[y];
-
-    uint16_t offset = (x + ((x < 10) ? (y * 10) : (80 + y * 3))) * 3;
-    // Serial.println(offset, HEX);
-
-    uint8_t *ptr = &ledbuf[1 + offset];
-    if ((x & 1) || (x == 12)) { // Odd columns + last column
-      // Rearrange color order vs constructor. Not a simple swap,
-      // needs to pass through table, or essentially (n + 2) % 3.
-      static const uint8_t remap[] = {2, 0, 1};
-      ptr[remap[rOffset]] = r;
-      ptr[remap[gOffset]] = g;
-      ptr[remap[bOffset]] = b;
-    } else {            // Even columns
-      ptr[rOffset] = r; // Color order follows constructor
-      ptr[gOffset] = g;
-      ptr[bOffset] = b;
-    }
+/**************************************************************************/
+/*!
+    @brief  Map native (unrotated) pixel position to LED buffer indices.
+    @param  x    The x position, already clipped & rotated.
+    @param  y    The y position, already clipped & rotated.
+    @param  idx  Array of 3 uint16_t to receive R,G,B indices.
+    @returns bool  Always true, every pixel on this board has an LED.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741_QT_buffered::mapPixel(int16_t x, int16_t y,
+                                               uint16_t *idx) {
+  // Remap the row (y)
+  static const uint8_t rowmap[] = {8, 5, 4, 3, 2, 1, 0, 7, 6};
+  y = rowmap[y];
+  uint16_t offset = (x + ((x < 10) ? (y * 10) : (80 + y * 3))) * 3;
+  if ((x & 1) || (x == 12)) { // Odd columns + last column
+    // Rearrange color order vs constructor. Not a simple swap,
+    // needs to pass through table, or essentially (n + 2) % 3.
+    static const uint8_t remap[] = {2, 0, 1};
+    idx[0] = offset + remap[rOffset];
+    idx[1] = offset + remap[gOffset];
+    idx[2] = offset + remap[bOffset];
+  } else {                     // Even columns
+    idx[0] = offset + rOffset; // Color order follows constructor
+    idx[1] = offset + gOffset;
+    idx[2] = offset + bOffset;
   }
+  return true;
 }
 
 // LED GLASSES -------------------------------------------------------------
@@ -830,6 +2030,34 @@ static const uint16_t PROGMEM glassesmatrix_ledmap[18 * 5 * 3] = {
     276,   22,    277,   // (17,4) / 7
 };
 
+// The 86 positions in glassesmatrix_ledmap that actually have LEDs, as
+// pixel numbers (x * 5 + y), in the same column-major order as the map.
+// The four holes are the top corners (0,0) and (17,0) and the two nose
+// bridge positions (8,4) and (9,4), i.e. pixels 0, 85, 44 and 49. Bulk
+// operations walk this list instead of all 90 positions, so there are no
+// holes to test for or skip.
+static const uint8_t PROGMEM glassesmatrix_pixels[86] = {
+    1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15,
+    16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30,
+    31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 45, 46,
+    47, 48, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62,
+    63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77,
+    78, 79, 80, 81, 82, 83, 84, 86, 87, 88, 89,
+};
+
+// For each of those pixels, offset of its 3x3 tile within the 54x15
+// GFXcanvas16 used by scale(): (y * 3) * 54 + x * 3.
+static const uint16_t PROGMEM glassesmatrix_tiles[86] = {
+    162, 324, 486, 648, 3,   165, 327, 489, 651, 6,   168, 330,
+    492, 654, 9,   171, 333, 495, 657, 12,  174, 336, 498, 660,
+    15,  177, 339, 501, 663, 18,  180, 342, 504, 666, 21,  183,
+    345, 507, 669, 24,  186, 348, 510, 27,  189, 351, 513, 30,
+    192, 354, 516, 678, 33,  195, 357, 519, 681, 36,  198, 360,
+    522, 684, 39,  201, 363, 525, 687, 42,  204, 366, 528, 690,
+    45,  207, 369, 531, 693, 48,  210, 372, 534, 696, 213, 375,
+    537, 699,
+};
+
 // Remap tables for LED ring pixel positions to LED indices, for
 // setPixelColor() functions.
 static const uint16_t PROGMEM left_ring_map[24 * 3] = {
@@ -953,6 +2181,29 @@ static const uint8_t PROGMEM gammaG[] = {
     225, 226, 227, 228, 229, 230, 231, 232, 233, 234, 236, 237, 238, 239, 240,
     241, 242, 243, 245, 246, 247, 248, 249, 250, 252, 253, 254, 255};
 
+// Sum one 3x3 tile of the EyeLights canvas into sum[3] (red, green, blue)
+// for the gamma tables above. If smooth, all 9 canvas pixels are added,
+// else just the center one times 9 (faster but jaggy).
+static void _IS31tileSum(const uint16_t *ptr, bool smooth, uint16_t *sum) {
+  if (smooth) {
+    sum[0] = sum[1] = sum[2] = 0;
+    for (uint8_t yy = 0; yy < 3; yy++) {
+      for (uint8_t xx = 0; xx < 3; xx++) {
+        uint16_t rgb = ptr[xx];
+        sum[0] += rgb >> 11;         // Accumulate 5 bits red,
+        sum[1] += (rgb >> 5) & 0x3F; // 6 bits green,
+        sum[2] += rgb & 0x1F;        // 5 bits blue
+      }
+      ptr += 18 * 3; // Advance one canvas scan line
+    }
+  } else {
+    uint16_t rgb = ptr[18 * 3 + 1];
+    sum[0] = (rgb >> 11) * 9;
+    sum[1] = ((rgb >> 5) & 0x3F) * 9;
+    sum[2] = (rgb & 0x1F) * 9;
+  }
+}
+
 /**************************************************************************/
 /*!
     @brief  Constructor for EyeLights LED ring. This is a base class used
@@ -1084,36 +2335,25 @@ void Adafruit_EyeLights::drawPixel(int16_t x, int16_t y, uint16_t color) {
             drawing operations directly to the low-resolution matrix,
             where these ops are "transparent" and empty pixels don't
             overwrite the rings.
+    @param  smooth  true (default) to average each 3x3 block of canvas
+                    pixels, false to just take the center one (faster
+                    but jaggy, e.g. when short on time per frame).
 */
 /**************************************************************************/
-void Adafruit_EyeLights::scale(void) {
+void Adafruit_EyeLights::scale(bool smooth) {
   if (canvas) {
-    uint16_t *src = canvas->getBuffer();
-    // Outer x/y loops are column-major on purpose (less pointer math)
-    for (int x = 0; x < 18; x++) {
-      uint16_t *ptr = &src[x * 3]; // Entry along top scan line w/x offset
-      for (int y = 0; y < 5; y++) {
-        uint16_t rsum = 0, gsum = 0, bsum = 0;
-        // Inner x/y loops are row-major on purpose (less pointer math)
-        for (uint8_t yy = 0; yy < 3; yy++) {
-          for (uint8_t xx = 0; xx < 3; xx++) {
-            uint16_t rgb = ptr[xx];
-            rsum += rgb >> 11;         // Accumulate 5 bits red,
-            gsum += (rgb >> 5) & 0x3F; // 6 bits green,
-            bsum += rgb & 0x1F;        // 5 bits blue
-          }
-          ptr += canvas->width(); // Advance one scan line
-        }
-        uint16_t base = (x * 5 + y) * 3; // Offset into ledmap
-        uint16_t ridx = pgm_read_word(&glassesmatrix_ledmap[base + rOffset]);
-        if (ridx != 65535) {
-          uint16_t gidx = pgm_read_word(&glassesmatrix_ledmap[base + gOffset]);
-          uint16_t bidx = pgm_read_word(&glassesmatrix_ledmap[base + bOffset]);
-          setLEDPWM(ridx, pgm_read_byte(&gammaRB[rsum]));
-          setLEDPWM(gidx, pgm_read_byte(&gammaG[gsum]));
-          setLEDPWM(bidx, pgm_read_byte(&gammaRB[bsum]));
-        }
-      }
+    const uint16_t *src = canvas->getBuffer();
+    // Only pixels with LEDs are visited, holes are already left out
+    for (uint8_t i = 0; i < sizeof glassesmatrix_pixels; i++) {
+      uint16_t sum[3];
+      _IS31tileSum(&src[pgm_read_word(&glassesmatrix_tiles[i])], smooth, sum);
+      uint16_t base = pgm_read_byte(&glassesmatrix_pixels[i]) * 3;
+      setLEDPWM(pgm_read_word(&glassesmatrix_ledmap[base + rOffset]),
+                pgm_read_byte(&gammaRB[sum[0]]));
+      setLEDPWM(pgm_read_word(&glassesmatrix_ledmap[base + gOffset]),
+                pgm_read_byte(&gammaG[sum[1]]));
+      setLEDPWM(pgm_read_word(&glassesmatrix_ledmap[base + bOffset]),
+                pgm_read_byte(&gammaRB[sum[2]]));
     }
   }
 }
@@ -1168,6 +2408,59 @@ void Adafruit_EyeLights_Ring_buffered::setPixelColor(int16_t n, uint8_t r,
   }
 }
 
+/**************************************************************************/
+/*!
+    @brief  Add a color to one pixel of one buffered EyeLights ring, rather
+            than replacing it, each of R,G,B clipping at 255. For glowing
+            effects where things overlap, like particles. No immediate
+            effect on LEDs; must follow up with show().
+    @param  n      Index of pixel to add to (0-23).
+    @param  color  RGB888 (24-bit) color, a la NeoPixel.
+*/
+/**************************************************************************/
+void Adafruit_EyeLights_Ring_buffered::addPixelColor(int16_t n,
+                                                     uint32_t color) {
+  if ((n >= 0) && (n < 24)) {
+    Adafruit_EyeLights_buffered *eyelights =
+        (Adafruit_EyeLights_buffered *)parent;
+    uint8_t *ledbuf = eyelights->getBuffer();
+    _IS31_SCALE_RGB_(color, r, g, b, _brightness);
+    n *= 3;
+    _IS31_ADD_SAT_(&ledbuf[pgm_read_word(&ring_map[n + eyelights->rOffset])],
+                   r);
+    _IS31_ADD_SAT_(&ledbuf[pgm_read_word(&ring_map[n + eyelights->gOffset])],
+                   g);
+    _IS31_ADD_SAT_(&ledbuf[pgm_read_word(&ring_map[n + eyelights->bOffset])],
+                   b);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set color of one pixel of one buffered EyeLights ring from an
+            interrupt handler, e.g. a timer updating an indicator while
+            the main loop renders the matrix. All three color elements
+            are updated together; see
+            Adafruit_IS31FL3741_buffered::setLEDsFromISR().
+    @param  n      Index of pixel to set (0-23).
+    @param  color  RGB888 (24-bit) color, a la NeoPixel.
+*/
+/**************************************************************************/
+void Adafruit_EyeLights_Ring_buffered::setPixelColorFromISR(int16_t n,
+                                                            uint32_t color) {
+  if ((n >= 0) && (n < 24)) {
+    Adafruit_EyeLights_buffered *eyelights =
+        (Adafruit_EyeLights_buffered *)parent;
+    _IS31_SCALE_RGB_(color, r, g, b, _brightness);
+    n *= 3;
+    uint16_t idx[3] = {pgm_read_word(&ring_map[n + eyelights->rOffset]),
+                       pgm_read_word(&ring_map[n + eyelights->gOffset]),
+                       pgm_read_word(&ring_map[n + eyelights->bOffset])};
+    uint8_t value[3] = {r, g, b};
+    eyelights->setLEDsFromISR(idx, value, 3);
+  }
+}
+
 /**************************************************************************/
 /*!
     @brief  Fill all pixels of one buffered EyeLights ring to same color,
@@ -1224,20 +2517,38 @@ void Adafruit_EyeLights_buffered::drawPixel(int16_t x, int16_t y,
                                             uint16_t color) {
   if ((x >= 0) && (x < width()) && (y >= 0) && (y < height())) {
     _IS31_ROTATE_(x, y); // Handle GFX-style soft rotation
-    x = (x * 5 + y) * 3; // Base index into ledmap
-    uint16_t ridx = pgm_read_word(&glassesmatrix_ledmap[x + rOffset]);
-    if (ridx != 65535) {
-      uint16_t gidx = pgm_read_word(&glassesmatrix_ledmap[x + gOffset]);
-      uint16_t bidx = pgm_read_word(&glassesmatrix_ledmap[x + bOffset]);
-      uint8_t *ledbuf = getBuffer();
+    uint16_t idx[3];
+    if (Adafruit_EyeLights_buffered::mapPixel(x, y, idx)) {
+      uint8_t *buf = getBuffer();
       _IS31_EXPAND_(color, r, g, b); // Expand GFX's RGB565 color to RGB888
-      ledbuf[ridx] = r;
-      ledbuf[gidx] = g;
-      ledbuf[bidx] = b;
+      buf[idx[0]] = r;
+      buf[idx[1]] = g;
+      buf[idx[2]] = b;
     }
   }
 }
 
+/**************************************************************************/
+/*!
+    @brief  Map native (unrotated) pixel position to LED buffer indices.
+    @param  x    The x position, already clipped & rotated.
+    @param  y    The y position, already clipped & rotated.
+    @param  idx  Array of 3 uint16_t to receive R,G,B indices.
+    @returns bool  true if an LED exists there, false for the few holes
+                   (corners and nose bridge) in the glasses matrix.
+*/
+/**************************************************************************/
+bool Adafruit_EyeLights_buffered::mapPixel(int16_t x, int16_t y,
+                                           uint16_t *idx) {
+  x = (x * 5 + y) * 3; // Base index into ledmap
+  idx[0] = pgm_read_word(&glassesmatrix_ledmap[x + rOffset]);
+  if (idx[0] == 65535)
+    return false;
+  idx[1] = pgm_read_word(&glassesmatrix_ledmap[x + gOffset]);
+  idx[2] = pgm_read_word(&glassesmatrix_ledmap[x + bOffset]);
+  return true;
+}
+
 /**************************************************************************/
 /*!
     @brief  Scales associated canvas (if one was requested via constructor)
@@ -1248,49 +2559,121 @@ void Adafruit_EyeLights_buffered::drawPixel(int16_t x, int16_t y,
             operations directly to the low-resolution matrix, where these
             ops are "transparent" and empty pixels don't overwrite the
             rings.
+    @param  smooth  true (default) to average each 3x3 block of canvas
+                    pixels, false to just take the center one (faster
+                    but jaggy, e.g. when short on time per frame).
 */
 /**************************************************************************/
-void Adafruit_EyeLights_buffered::scale(void) {
+void Adafruit_EyeLights_buffered::scale(bool smooth) {
   if (canvas) {
-    uint16_t *src = canvas->getBuffer();
+    const uint16_t *src = canvas->getBuffer();
     uint8_t *ledbuf = getBuffer();
-    // Outer x/y loops are column-major on purpose (less pointer math)
-    for (int x = 0; x < 18; x++) {
-      uint16_t *ptr = &src[x * 3]; // Entry along top scan line w/x offset
-      for (int y = 0; y < 5; y++) {
-        uint16_t rsum = 0, gsum = 0, bsum = 0;
-        // Inner x/y loops are row-major on purpose (less pointer math)
-        for (uint8_t yy = 0; yy < 3; yy++) {
-          for (uint8_t xx = 0; xx < 3; xx++) {
-            uint16_t rgb = ptr[xx];
-            rsum += rgb >> 11;         // Accumulate 5 bits red,
-            gsum += (rgb >> 5) & 0x3F; // 6 bits green,
-            bsum += rgb & 0x1F;        // 5 bits blue
-          }
-          ptr += canvas->width(); // Advance one scan line
-        }
-        uint16_t base = (x * 5 + y) * 3; // Offset into ledmap
-        uint16_t ridx = pgm_read_word(&glassesmatrix_ledmap[base + rOffset]);
-        if (ridx != 65535) {
-          uint16_t gidx = pgm_read_word(&glassesmatrix_ledmap[base + gOffset]);
-          uint16_t bidx = pgm_read_word(&glassesmatrix_ledmap[base + bOffset]);
-          ledbuf[ridx] = pgm_read_byte(&gammaRB[rsum]);
-          ledbuf[gidx] = pgm_read_byte(&gammaG[gsum]);
-          ledbuf[bidx] = pgm_read_byte(&gammaRB[bsum]);
-        }
-      }
+    // Only pixels with LEDs are visited, holes are already left out
+    for (uint8_t i = 0; i < sizeof glassesmatrix_pixels; i++) {
+      uint16_t sum[3];
+      _IS31tileSum(&src[pgm_read_word(&glassesmatrix_tiles[i])], smooth, sum);
+      uint16_t base = pgm_read_byte(&glassesmatrix_pixels[i]) * 3;
+      ledbuf[pgm_read_word(&glassesmatrix_ledmap[base + rOffset])] =
+          pgm_read_byte(&gammaRB[sum[0]]);
+      ledbuf[pgm_read_word(&glassesmatrix_ledmap[base + gOffset])] =
+          pgm_read_byte(&gammaG[sum[1]]);
+      ledbuf[pgm_read_word(&glassesmatrix_ledmap[base + bOffset])] =
+          pgm_read_byte(&gammaRB[sum[2]]);
     }
   }
 }
 
-// ORIGINAL LED GLASSES API (DIRECT, UNBUFFERED) ---------------------------
-// These classes and functions are deprecated in favor of the EyeLights
-// versions, which are a bit simpler to use. Code is kept around for
-// compatibility but might be removed in the future.
-
 /**************************************************************************/
 /*!
-    @brief         Adafruit GFX low level accessor - sets an RGB pixel value,
+    @brief  Fill the EyeLights matrix with one color. Same result as the
+            general fill(), but walks only the pixels that have LEDs
+            rather than drawing every position and testing for holes.
+            As with the general fill(), a color whose high and low bytes
+            match (e.g. 0 to clear) sets the whole LED buffer, rings
+            included.
+    @param  color  16-bit RGB565 packed color (expands to 888 for LEDs).
+*/
+/**************************************************************************/
+void Adafruit_EyeLights_buffered::fill(uint16_t color) {
+  if ((color >> 8) == (color & 0xFF)) {
+    Adafruit_IS31FL3741_colorGFX_buffered::fill(color);
+  } else {
+    _IS31_EXPAND_(color, r, g, b); // Expand GFX's RGB565 color to RGB888
+    uint8_t *ledbuf = getBuffer();
+    for (uint8_t i = 0; i < sizeof glassesmatrix_pixels; i++) {
+      uint16_t base = pgm_read_byte(&glassesmatrix_pixels[i]) * 3;
+      ledbuf[pgm_read_word(&glassesmatrix_ledmap[base + rOffset])] = r;
+      ledbuf[pgm_read_word(&glassesmatrix_ledmap[base + gOffset])] = g;
+      ledbuf[pgm_read_word(&glassesmatrix_ledmap[base + bOffset])] = b;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief    Set the scaling level of every LED for white balance, same as
+              the general setWhiteBalance(), but with the gains also
+              applied to both rings' LEDs.
+    @param    balance  Red, green and blue gains packed as 0xRRGGBB.
+    @param    scales   Pointer to 351 per-LED calibration values, indexed
+                       same as getBuffer(), or NULL (default) for none.
+    @param    progmem  If true, scales table is in PROGMEM. Default is
+                       false (RAM).
+    @returns  true if I2C transfers completed successfully, false on error.
+*/
+/**************************************************************************/
+bool Adafruit_EyeLights_buffered::setWhiteBalance(uint32_t balance,
+                                                  const uint8_t *scales,
+                                                  bool progmem) {
+  _IS31balance b = {this, balance, scales, progmem};
+  uint8_t buf[32]; // See notes in fillTwoPages()
+  return writeTwoPages(2, buf, sizeof buf - 1, ringBalanceChunk, &b);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fill one chunk of scaling registers for setWhiteBalance(): the
+            matrix as in the general case, then ring LEDs in the chunk.
+            Some ring LEDs are also matrix pixels, so ring values are set
+            from the calibration value rather than scaled in place, which
+            would apply the gain twice to those.
+    @param  data   Chunk of scaling values to fill.
+    @param  start  LED index of data[0].
+    @param  len    Number of values in chunk.
+    @param  arg    Pointer to _IS31balance settings.
+*/
+/**************************************************************************/
+void Adafruit_EyeLights_buffered::ringBalanceChunk(uint8_t *data,
+                                                   uint16_t start, uint8_t len,
+                                                   void *arg) {
+  balanceChunk(data, start, len, arg);
+  const _IS31balance *b = (const _IS31balance *)arg;
+  Adafruit_EyeLights_buffered *eyelights =
+      (Adafruit_EyeLights_buffered *)b->display;
+  const uint8_t offset[] = {eyelights->rOffset, eyelights->gOffset,
+                            eyelights->bOffset};
+  for (uint8_t ring = 0; ring < 2; ring++) {
+    const uint16_t *map = ring ? right_ring_map : left_ring_map;
+    for (uint8_t n = 0; n < 24 * 3; n += 3) {
+      for (uint8_t c = 0; c < 3; c++) {
+        uint16_t led = pgm_read_word(&map[n + offset[c]]);
+        // Unsigned math, so anything before start is also out of range
+        uint16_t i = led - start;
+        if (i < len)
+          data[i] = _IS31applyGain(_IS31calibration(b, led), b->balance, c);
+      }
+    }
+  }
+}
+
+// ORIGINAL LED GLASSES API (DIRECT, UNBUFFERED) ---------------------------
+// These classes and functions are deprecated in favor of the EyeLights
+// versions, which are a bit simpler to use. Code is kept around for
+// compatibility but might be removed in the future.
+
+/**************************************************************************/
+/*!
+    @brief         Adafruit GFX low level accessor - sets an RGB pixel value,
                    handles rotation and pixel arrangement, unlike setLEDPWM.
     @param  x      The x position, starting with 0 for left-most side
     @param  y      The y position, starting with 0 for top-most side
@@ -1526,3 +2909,2689 @@ void Adafruit_IS31FL3741_GlassesRing_buffered::fill(uint32_t color) {
     ledbuf[pgm_read_word(&ring_map[n])] = b;
   }
 }
+
+// PROCEDURAL EFFECTS ------------------------------------------------------
+
+// Ken Perlin's reference permutation table, used by noise16() to pick a
+// pseudorandom gradient at each lattice point. Not doubled as in the
+// reference code; indices wrap with uint8_t casts instead, saving 256
+// bytes of flash.
+static const uint8_t PROGMEM _IS31NoisePerm[256] = {
+    151, 160, 137, 91,  90,  15,  131, 13,  201, 95,  96,  53,  194, 233, 7,
+    225, 140, 36,  103, 30,  69,  142, 8,   99,  37,  240, 21,  10,  23,  190,
+    6,   148, 247, 120, 234, 75,  0,   26,  197, 62,  94,  252, 219, 203, 117,
+    35,  11,  32,  57,  177, 33,  88,  237, 149, 56,  87,  174, 20,  125, 136,
+    171, 168, 68,  175, 74,  165, 71,  134, 139, 48,  27,  166, 77,  146, 158,
+    231, 83,  111, 229, 122, 60,  211, 133, 230, 220, 105, 92,  41,  55,  46,
+    245, 40,  244, 102, 143, 54,  65,  25,  63,  161, 1,   216, 80,  73,  209,
+    76,  132, 187, 208, 89,  18,  169, 200, 196, 135, 130, 116, 188, 159, 86,
+    164, 100, 109, 198, 173, 186, 3,   64,  52,  217, 226, 250, 124, 123, 5,
+    202, 38,  147, 118, 126, 255, 82,  85,  212, 207, 206, 59,  227, 47,  16,
+    58,  17,  182, 189, 28,  42,  223, 183, 170, 213, 119, 248, 152, 2,   44,
+    154, 163, 70,  221, 153, 101, 155, 167, 43,  172, 9,   129, 22,  39,  253,
+    19,  98,  108, 110, 79,  113, 224, 232, 178, 185, 112, 104, 218, 246, 97,
+    228, 251, 34,  242, 193, 238, 210, 144, 12,  191, 179, 162, 241, 81,  51,
+    145, 235, 249, 14,  239, 107, 49,  192, 214, 31,  181, 199, 106, 157, 184,
+    84,  204, 176, 115, 121, 50,  45,  127, 4,   150, 254, 138, 236, 205, 93,
+    222, 114, 67,  29,  24,  72,  243, 141, 128, 195, 78,  66,  215, 61,  156,
+    180};
+
+// The 12 gradient directions of 3D simplex noise (cube edge midpoints).
+static const int8_t PROGMEM _IS31NoiseGrad[12][3] = {
+    {1, 1, 0},  {-1, 1, 0},  {1, -1, 0}, {-1, -1, 0}, {1, 0, 1},  {-1, 0, 1},
+    {1, 0, -1}, {-1, 0, -1}, {0, 1, 1},  {0, -1, 1},  {0, 1, -1}, {0, -1, -1}};
+
+/**************************************************************************/
+/*!
+  @brief   Fixed-point 3D simplex noise, smooth pseudorandom "clouds" for
+           organic-looking effects without floating-point math. Usually
+           X & Y are pixel position times some scale and Z is time.
+           Pattern repeats every 256 units on each axis.
+  @param   x  X position, 8.8 fixed-point (256 = one noise cell).
+  @param   y  Y position, 8.8 fixed-point.
+  @param   z  Z position, 8.8 fixed-point.
+  @return  Noise value, -32767 to +32767 (within ~2% of the floating-
+           point reference implementation).
+*/
+/**************************************************************************/
+int16_t Adafruit_IS31FL3741_Effects::noise16(uint16_t x, uint16_t y,
+                                             uint16_t z) {
+  // Work in Q12 (4096 = 1.0) so squared distances fit in 32 bits.
+  // Skew input space to find which simplex cell we're in...
+  int32_t X = (int32_t)x << 4, Y = (int32_t)y << 4, Z = (int32_t)z << 4;
+  int32_t s = (X + Y + Z) / 3; // Skew factor 1/3
+  int32_t i = (X + s) >> 12, j = (Y + s) >> 12, k = (Z + s) >> 12;
+  // ...then unskew cell origin back to XYZ space, distance from there
+  int32_t t = ((i + j + k) << 12) / 6; // Unskew factor 1/6
+  int32_t x0 = X - (i << 12) + t, y0 = Y - (j << 12) + t,
+          z0 = Z - (k << 12) + t;
+
+  // Determine which of 6 tetrahedra we're in, giving the offsets of the
+  // second and third corners (first is 0,0,0 and fourth is 1,1,1).
+  uint8_t i1, j1, k1, i2, j2, k2;
+  if (x0 >= y0) {
+    if (y0 >= z0) { //          X Y Z order
+      i1 = i2 = j2 = 1;
+      j1 = k1 = k2 = 0;
+    } else if (x0 >= z0) { //   X Z Y order
+      i1 = i2 = k2 = 1;
+      j1 = k1 = j2 = 0;
+    } else { //                 Z X Y order
+      k1 = i2 = k2 = 1;
+      i1 = j1 = j2 = 0;
+    }
+  } else {
+    if (y0 < z0) { //           Z Y X order
+      k1 = j2 = k2 = 1;
+      i1 = j1 = i2 = 0;
+    } else if (x0 < z0) { //    Y Z X order
+      j1 = j2 = k2 = 1;
+      i1 = k1 = i2 = 0;
+    } else { //                 Y X Z order
+      j1 = i2 = j2 = 1;
+      i1 = k1 = k2 = 0;
+    }
+  }
+
+  // Sum contributions from the four corners
+  int32_t n = 0;
+  for (uint8_t c = 0; c < 4; c++) {
+    uint8_t di, dj, dk;
+    switch (c) {
+    case 0:
+      di = dj = dk = 0;
+      break;
+    case 1:
+      di = i1;
+      dj = j1;
+      dk = k1;
+      break;
+    case 2:
+      di = i2;
+      dj = j2;
+      dk = k2;
+      break;
+    default:
+      di = dj = dk = 1;
+      break;
+    }
+    // Distance to this corner; c * 1/6 is the unskew offset (683 = Q12)
+    int32_t xs = x0 - ((int32_t)di << 12) + c * 683;
+    int32_t ys = y0 - ((int32_t)dj << 12) + c * 683;
+    int32_t zs = z0 - ((int32_t)dk << 12) + c * 683;
+    int32_t tt = 2458 - ((xs * xs + ys * ys + zs * zs) >> 12); // 0.6 - d^2
+    if (tt > 0) { // Corner is within range
+      uint8_t h = pgm_read_byte(
+          &_IS31NoisePerm[(uint8_t)(
+              i + di +
+              pgm_read_byte(&_IS31NoisePerm[(uint8_t)(
+                  j + dj +
+                  pgm_read_byte(&_IS31NoisePerm[(uint8_t)(k + dk)]))]))]);
+      const int8_t *g = _IS31NoiseGrad[h % 12];
+      tt = (tt * tt) >> 12; // tt^4, keeping Q12
+      tt = (tt * tt) >> 12;
+      n += tt * ((int8_t)pgm_read_byte(&g[0]) * xs +
+                 (int8_t)pgm_read_byte(&g[1]) * ys +
+                 (int8_t)pgm_read_byte(&g[2]) * zs);
+    }
+  }
+  n >>= 4; // Q24 * 32 (reference scale factor) -> Q15
+  if (n > 32767)
+    n = 32767;
+  else if (n < -32767)
+    n = -32767;
+  return n;
+}
+
+/**************************************************************************/
+/*!
+  @brief   Convert a "heat" value to a black-red-yellow-white color ramp,
+           as used by fire() (and FastLED's HeatColor(), if familiar).
+  @param   heat  Temperature, 0 (black) to 255 (white hot).
+  @return  Packed 24-bit RGB color.
+*/
+/**************************************************************************/
+uint32_t Adafruit_IS31FL3741_Effects::heatColor(uint8_t heat) {
+  uint8_t t192 = ((uint16_t)heat * 191) >> 8; // Scale to 0-191
+  uint8_t ramp = (t192 & 0x3F) << 2;          // 0-252 within each third
+  if (t192 & 0x80)
+    return 0xFFFF00 | ramp; // Hottest third, yellow to white
+  if (t192 & 0x40)
+    return 0xFF0000 | ((uint16_t)ramp << 8); // Middle, red to yellow
+  return (uint32_t)ramp << 16;               // Coolest, black to red
+}
+
+/**************************************************************************/
+/*!
+  @brief   Fast 8-bit pseudorandom number (xorshift32), so effects don't
+           depend on (and don't disturb the sequence of) Arduino random().
+  @return  Pseudorandom value, 0 to 255.
+*/
+/**************************************************************************/
+uint8_t Adafruit_IS31FL3741_Effects::random8(void) {
+  _seed ^= _seed << 13;
+  _seed ^= _seed >> 17;
+  _seed ^= _seed << 5;
+  return _seed >> 24;
+}
+
+/**************************************************************************/
+/*!
+  @brief   Set one pixel in the display's LED buffer to an RGB888 color,
+           skipping holes in the matrix (e.g. EyeLights corners).
+  @param   x      The x position, starting with 0 for left-most side.
+  @param   y      The y position, starting with 0 for top-most side.
+  @param   color  Packed 24-bit RGB color.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_Effects::setLED(int16_t x, int16_t y,
+                                         uint32_t color) {
+  uint16_t idx[3];
+  if (_display->getLEDIndices(x, y, idx)) {
+    uint8_t *ledbuf = _display->getBuffer();
+    ledbuf[idx[0]] = color >> 16;
+    ledbuf[idx[1]] = color >> 8;
+    ledbuf[idx[2]] = color;
+  }
+}
+
+/**************************************************************************/
+/*!
+  @brief   Plasma effect, three interfering sine waves mapped to the color
+           wheel. Costs three sin16() and one ColorHSV() per pixel.
+  @param   speed  Animation rate, 0 (frozen) to 255 (very fast).
+  @param   scale  Wave density, larger values = more waves across matrix.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_Effects::plasma(uint8_t speed, uint8_t scale) {
+  _time += speed;
+  // Each wave moves at a different rate and direction
+  uint16_t t1 = _time * 64, t2 = _time * -48, t3 = _time * 40;
+  for (int16_t y = 0; y < _display->height(); y++) {
+    int16_t wy = _display->sin16((uint16_t)(y * scale) * 256 + t2);
+    for (int16_t x = 0; x < _display->width(); x++) {
+      int32_t sum = wy + _display->sin16((uint16_t)(x * scale) * 256 + t1) +
+                    _display->sin16((uint16_t)((x + y) * scale) * 128 + t3);
+      setLED(x, y,
+             _display->gamma32(_display->ColorHSV((sum >> 1) + _time * 32)));
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+  @brief   Noise effect, drifting clouds of color and shadow around a
+           base hue. Costs one noise16() and one ColorHSV() per pixel.
+  @param   speed  Animation rate, 0 (frozen) to 255 (very fast).
+  @param   scale  Noise zoom, 256 = one noise cell per pixel (busy),
+                  smaller values are smoother.
+  @param   hue    Base color, 0-65535 as in ColorHSV(). Noise varies
+                  about 1/8 of the color wheel either side of this.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_Effects::noise(uint8_t speed, uint8_t scale,
+                                        uint16_t hue) {
+  _time += speed;
+  uint16_t z = _time * 4;
+  for (int16_t y = 0; y < _display->height(); y++) {
+    for (int16_t x = 0; x < _display->width(); x++) {
+      int16_t n = noise16(x * scale + _time, y * scale, z);
+      setLED(x, y,
+             _display->gamma32(
+                 _display->ColorHSV(hue + (n >> 2), 255, 128 + (n >> 8))));
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+  @brief   Fire effect, heat rising from the bottom row and cooling as it
+           goes, same idea as the popular Fire2012 but in 2D: each cell
+           takes a weighted average of the three cells below it. Costs
+           one random8() and one heatColor() per pixel.
+  @param   cooling   How quickly flames cool as they rise, 20 (tall
+                     flames) to 100 (short flames).
+  @param   sparking  Chance (out of 255) per frame of a new spark in each
+                     bottom-row column, 50 (sparse) to 200 (roaring).
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_Effects::fire(uint8_t cooling, uint8_t sparking) {
+  int16_t w = _display->width(), h = _display->height();
+  // Capped so it fits the 8-bit random cooling below (and is never 0)
+  uint16_t maxCool = ((uint16_t)cooling * 10) / h + 2;
+  if (maxCool > 255)
+    maxCool = 255;
+
+  // Heat diffuses upward, top row first so the rows below are still
+  // last frame's values. Bottom row isn't diffused, it's the fuel.
+  for (int16_t y = 0; y < h - 1; y++) {
+    uint8_t *row = &_state[y * w], *below = row + w;
+    for (int16_t x = 0; x < w; x++) {
+      uint8_t left = below[(x > 0) ? x - 1 : x];
+      uint8_t right = below[(x < w - 1) ? x + 1 : x];
+      row[x] = ((uint16_t)below[x] * 2 + left + right) >> 2;
+    }
+  }
+  // Everything cools a little, then new sparks ignite along the bottom
+  for (int16_t i = 0; i < w * h; i++) {
+    uint8_t cool = random8() % maxCool;
+    _state[i] = (_state[i] > cool) ? _state[i] - cool : 0;
+  }
+  uint8_t *base = &_state[(h - 1) * w];
+  for (int16_t x = 0; x < w; x++) {
+    if (random8() < sparking) {
+      uint16_t heat = base[x] + 160 + (random8() % 96);
+      base[x] = (heat > 255) ? 255 : heat;
+    }
+  }
+
+  for (int16_t y = 0; y < h; y++) {
+    for (int16_t x = 0; x < w; x++) {
+      setLED(x, y, heatColor(_state[y * w + x]));
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+  @brief   Twinkle effect, random pixels flash on and fade out. Costs one
+           random8() and one gamma8() per pixel.
+  @param   color    Packed 24-bit RGB color of twinkles.
+  @param   density  Chance (out of 255) per frame of an unlit pixel
+                    lighting up.
+  @param   fade     How much each twinkle dims per frame, 1 (slow) to 255
+                    (instant).
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_Effects::twinkle(uint32_t color, uint8_t density,
+                                          uint8_t fade) {
+  int16_t w = _display->width(), h = _display->height();
+  for (int16_t y = 0; y < h; y++) {
+    for (int16_t x = 0; x < w; x++) {
+      uint8_t *level = &_state[y * w + x];
+      if (*level > fade) {
+        *level -= fade;
+      } else {
+        *level = (random8() < density) ? 255 : 0;
+      }
+      uint16_t brightness = _display->gamma8(*level) + 1; // 1-256
+      _IS31_SCALE_RGB_(color, r, g, b, brightness);
+      setLED(x, y, _display->Color(r, g, b));
+    }
+  }
+}
+
+// PARTICLES ---------------------------------------------------------------
+
+/**************************************************************************/
+/*!
+    @brief  Constructor for particle system. Not invoked by user code, use
+            Adafruit_IS31FL3741_ParticlePool, which provides the storage.
+    @param  display   Pointer to buffered matrix object to draw into.
+    @param  capacity  Maximum number of particles.
+    @param  x         Array of capacity int16_t for X positions.
+    @param  y         Array of capacity int16_t for Y positions.
+    @param  vx        Array of capacity int16_t for X velocities.
+    @param  vy        Array of capacity int16_t for Y velocities.
+    @param  phase     Array of capacity uint16_t for ages.
+    @param  rate      Array of capacity uint16_t for aging rates.
+    @param  hue       Array of capacity uint16_t for hues.
+*/
+/**************************************************************************/
+Adafruit_IS31FL3741_Particles::Adafruit_IS31FL3741_Particles(
+    Adafruit_IS31FL3741_colorGFX_buffered *display, uint16_t capacity,
+    int16_t *x, int16_t *y, int16_t *vx, int16_t *vy, uint16_t *phase,
+    uint16_t *rate, uint16_t *hue)
+    : _display(display), _x(x), _y(y), _vx(vx), _vy(vy), _phase(phase),
+      _rate(rate), _hue(hue), _rampStops(0), _capacity(capacity) {}
+
+/**************************************************************************/
+/*!
+    @brief   Add a new particle, if there's room in the pool.
+    @param   x     Initial X position, 8.8 fixed-point pixels (e.g. 256 * 3
+                   + 128 is the center of column 3).
+    @param   y     Initial Y position, 8.8 fixed-point pixels.
+    @param   vx    X velocity, 8.8 fixed-point pixels per update().
+    @param   vy    Y velocity, 8.8 fixed-point pixels per update().
+    @param   life  Lifespan in frames (update() calls), 1 to 255.
+    @param   hue   Color, 0-65535 as in ColorHSV(), fading to black with
+                   age. Ignored if a color ramp has been set.
+    @return  Index of new particle, or -1 if pool is full.
+*/
+/**************************************************************************/
+int16_t Adafruit_IS31FL3741_Particles::spawn(int16_t x, int16_t y,
+                                             int16_t vx, int16_t vy,
+                                             uint8_t life, uint16_t hue) {
+  if (_count >= _capacity)
+    return -1;
+  uint16_t i = _count++;
+  _x[i] = x;
+  _y[i] = y;
+  _vx[i] = vx;
+  _vy[i] = vy;
+  _phase[i] = 0;
+  // Aging by a fixed step avoids a divide per particle per frame later
+  _rate[i] = 65535 / (life ? life : 1);
+  _hue[i] = hue;
+  return i;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Remove one particle. Last particle is moved into its place, so
+            the live ones are always contiguous and no search is needed.
+    @param  i  Index of particle to remove.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_Particles::kill(uint16_t i) {
+  uint16_t last = --_count;
+  _x[i] = _x[last];
+  _y[i] = _y[last];
+  _vx[i] = _vx[last];
+  _vy[i] = _vy[last];
+  _phase[i] = _phase[last];
+  _rate[i] = _rate[last];
+  _hue[i] = _hue[last];
+}
+
+/**************************************************************************/
+/*!
+    @brief  Advance all particles by one frame: age them, apply gravity and
+            drag, and move. Particles reaching the end of their lifespan
+            are removed.
+    @param  cull  If true (default), particles more than one pixel off the
+                  matrix are removed too. Pass false when rendering to an
+                  EyeLights ring, where X instead wraps around the 24
+                  ring positions.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_Particles::update(bool cull) {
+  int32_t xmax = ((int32_t)_display->width() + 1) << 8;
+  int32_t ymax = ((int32_t)_display->height() + 1) << 8;
+  for (uint16_t i = 0; i < _count;) {
+    uint16_t phase = _phase[i] + _rate[i];
+    if (phase < _phase[i]) { // Rolled over, end of life
+      kill(i);
+      continue; // Don't i++, last particle was moved here
+    }
+    _phase[i] = phase;
+    int32_t vx = ((int32_t)_vx[i] + _gx) * _drag >> 8;
+    int32_t vy = ((int32_t)_vy[i] + _gy) * _drag >> 8;
+    _vx[i] = (vx > 32767) ? 32767 : (vx < -32767) ? -32767 : vx;
+    _vy[i] = (vy > 32767) ? 32767 : (vy < -32767) ? -32767 : vy;
+    int32_t x = (int32_t)_x[i] + _vx[i];
+    int32_t y = (int32_t)_y[i] + _vy[i];
+    if (cull) {
+      if ((x < -256) || (y < -256) || (x >= xmax) || (y >= ymax)) {
+        kill(i);
+        continue;
+      }
+    } else {
+      while (x < 0) // Wrap around ring, 24 pixels
+        x += 24 * 256;
+      while (x >= 24 * 256)
+        x -= 24 * 256;
+      y = (y > 32767) ? 32767 : (y < -32767) ? -32767 : y;
+    }
+    _x[i] = x;
+    _y[i] = y;
+    i++;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set a color ramp that all particles follow over their
+            lifespans, instead of each fading out its own hue. e.g. for
+            sparks, {white, yellow, red, black}.
+    @param  colors  Array of packed 24-bit RGB colors, from birth to death.
+    @param  n       Number of colors, up to 4 (more are ignored). Use 0 to
+                    go back to per-particle hues.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_Particles::setColorRamp(const uint32_t *colors,
+                                                 uint8_t n) {
+  if (n > 4)
+    n = 4;
+  for (uint8_t i = 0; i < n; i++)
+    _ramp[i] = colors[i];
+  _rampStops = n;
+}
+
+/**************************************************************************/
+/*!
+    @brief   Current color of one particle, from its age.
+    @param   i  Index of particle.
+    @return  Packed 24-bit RGB color.
+*/
+/**************************************************************************/
+uint32_t Adafruit_IS31FL3741_Particles::color(uint16_t i) const {
+  uint8_t age = _phase[i] >> 8; // 0-255
+  if (!_rampStops)
+    return _display->ColorHSV(_hue[i], 255, 255 - age);
+  if (_rampStops == 1)
+    return _ramp[0];
+  uint16_t pos = (uint16_t)age * (_rampStops - 1); // Position along ramp
+  uint8_t seg = pos >> 8, frac = pos & 0xFF;
+  uint32_t c1 = _ramp[seg], c2 = _ramp[seg + 1], result = 0;
+  for (uint8_t shift = 0; shift < 24; shift += 8) {
+    int16_t a = (c1 >> shift) & 0xFF, b = (c2 >> shift) & 0xFF;
+    result |= (uint32_t)(uint8_t)(a + ((int32_t)(b - a) * frac >> 8)) << shift;
+  }
+  return result;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Add all particles into the matrix's LED buffer. Each is spread
+            across the four nearest pixels by its fractional position, so
+            slow movement is smooth rather than jumping pixel to pixel.
+            Holes in the matrix (e.g. EyeLights corners) are skipped. No
+            immediate effect on LEDs; must follow up with show().
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_Particles::render(void) {
+  uint8_t *ledbuf = _display->getBuffer();
+  for (uint16_t i = 0; i < _count; i++) {
+    uint32_t c = color(i);
+    uint8_t r = c >> 16, g = c >> 8, b = c;
+    // Positions relative to pixel centers. Culling in update() keeps
+    // these above -512, so the +512 offset lets >> act as floor().
+    int16_t px = _x[i] - 128, py = _y[i] - 128;
+    int16_t ix = ((px + 512) >> 8) - 2, iy = ((py + 512) >> 8) - 2;
+    uint8_t fx = px & 0xFF, fy = py & 0xFF;
+    for (uint8_t j = 0; j < 4; j++) {
+      uint16_t wx = (j & 1) ? fx : 256 - fx;
+      uint16_t wy = (j & 2) ? fy : 256 - fy;
+      uint16_t w = ((uint32_t)wx * wy) >> 8; // 0-256
+      uint16_t idx[3];
+      if (w && _display->getLEDIndices(ix + (j & 1), iy + (j >> 1), idx)) {
+        _IS31_ADD_SAT_(&ledbuf[idx[0]], (r * w) >> 8);
+        _IS31_ADD_SAT_(&ledbuf[idx[1]], (g * w) >> 8);
+        _IS31_ADD_SAT_(&ledbuf[idx[2]], (b * w) >> 8);
+      }
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Add all particles into an EyeLights ring, using only their X
+            positions (0 to 24 * 256, wrapping around). Each is spread
+            across the two nearest ring pixels. Ring brightness setting
+            applies. No immediate effect on LEDs; must follow up with
+            show().
+    @param  ring  Pointer to ring, e.g. &glasses.left_ring.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_Particles::render(
+    Adafruit_EyeLights_Ring_buffered *ring) {
+  for (uint16_t i = 0; i < _count; i++) {
+    uint32_t c = color(i);
+    int16_t pos = _x[i] - 128; // Relative to pixel centers
+    while (pos < 0)
+      pos += 24 * 256;
+    while (pos >= 24 * 256)
+      pos -= 24 * 256;
+    uint8_t n = pos >> 8, f = pos & 0xFF;
+    uint16_t w1 = f, w0 = 256 - f;
+    uint8_t r = c >> 16, g = c >> 8, b = c;
+    ring->addPixelColor(n, _display->Color((r * w0) >> 8, (g * w0) >> 8,
+                                           (b * w0) >> 8));
+    if (w1) {
+      ring->addPixelColor((n + 1) % 24,
+                          _display->Color((r * w1) >> 8, (g * w1) >> 8,
+                                          (b * w1) >> 8));
+    }
+  }
+}
+
+// AUDIO SPECTRUM ----------------------------------------------------------
+
+/**************************************************************************/
+/*!
+    @brief  In-place fixed-point FFT (radix-2, decimation in time), using
+            the sin16() table for twiddle factors. Each stage halves its
+            results so nothing can overflow, i.e. output is the true
+            transform divided by the number of points. For real-valued
+            input (imaginary parts all 0), which is the case for audio.
+    @param  re     Array of 2^log2n int16_t real parts, replaced with
+                   real parts of result.
+    @param  im     Array of 2^log2n int16_t imaginary parts, replaced with
+                   imaginary parts of result.
+    @param  log2n  Number of points as a power of 2, e.g. 7 for 128.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_Spectrum::fft(int16_t *re, int16_t *im,
+                                       uint8_t log2n) {
+  uint16_t n = 1 << log2n;
+  // Reorder inputs by bit-reversed index
+  for (uint16_t i = 1, j = 0; i < n; i++) {
+    uint16_t bit = n >> 1;
+    for (; j & bit; bit >>= 1)
+      j ^= bit;
+    j ^= bit;
+    if (i < j) {
+      int16_t t = re[i];
+      re[i] = re[j];
+      re[j] = t;
+      t = im[i];
+      im[i] = im[j];
+      im[j] = t;
+    }
+  }
+  // Butterflies, loops arranged so each twiddle is calculated just once
+  for (uint8_t stage = 1; stage <= log2n; stage++) {
+    uint16_t half = 1 << (stage - 1), len = half * 2;
+    uint16_t step = 65536UL >> stage; // sin16() angle between twiddles
+    for (uint16_t k = 0; k < half; k++) {
+      int16_t wr = Adafruit_IS31FL3741::cos16(k * step);
+      int16_t wi = -Adafruit_IS31FL3741::sin16(k * step);
+      for (uint16_t i = k; i < n; i += len) {
+        uint16_t j = i + half;
+        int32_t tr = ((int32_t)wr * re[j] - (int32_t)wi * im[j]) >> 15;
+        int32_t ti = ((int32_t)wr * im[j] + (int32_t)wi * re[j]) >> 15;
+        re[j] = (re[i] - tr) >> 1;
+        im[j] = (im[i] - ti) >> 1;
+        re[i] = (re[i] + tr) >> 1;
+        im[i] = (im[i] + ti) >> 1;
+      }
+    }
+  }
+}
+
+// Integer log2 of a 16-bit value in 4.4 fixed-point (0-255), approximated
+// linearly between powers of two. 0 in = 0 out, same as 1.
+static uint8_t _IS31log16(uint16_t m) {
+  if (!m)
+    return 0;
+  uint8_t e = 15;
+  while (!(m & 0x8000)) {
+    m <<= 1;
+    e--;
+  }
+  return (e << 4) | ((m >> 11) & 0x0F);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Analyze one block of audio samples, updating bar and peak
+            levels. Call this once per block as audio arrives, and
+            render() as often as the display is updated.
+    @param  samples  Array of IS3741_SPECTRUM_SAMPLES (128) signed 16-bit
+                     PCM samples. If the source is 8- or 12-bit, or
+                     unsigned, convert first (e.g. (s - 2048) * 16).
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_Spectrum::process(const int16_t *samples) {
+  // Hann window tapers ends of block, reduces smearing between bands
+  for (uint16_t i = 0; i < IS3741_SPECTRUM_SAMPLES; i++) {
+    int32_t hann = (32767 - Adafruit_IS31FL3741::cos16(
+                                i * (65536UL / IS3741_SPECTRUM_SAMPLES))) >>
+                   1;
+    _re[i] = (samples[i] * hann) >> 15;
+    _im[i] = 0;
+  }
+  fft(_re, _im, 7); // 2^7 = 128 points
+  // Replace first half of re[] with log magnitude of each frequency bin.
+  // Magnitude approximated as max + 3/8 min, no square root needed.
+  for (uint8_t i = 1; i < IS3741_SPECTRUM_SAMPLES / 2; i++) {
+    uint16_t a = (_re[i] < 0) ? -(int32_t)_re[i] : _re[i];
+    uint16_t b = (_im[i] < 0) ? -(int32_t)_im[i] : _im[i];
+    if (a < b) {
+      uint16_t t = a;
+      a = b;
+      b = t;
+    }
+    _re[i] = _IS31log16(a + (b >> 2) + (b >> 3));
+  }
+  uint8_t columns = _display->width();
+  bands((columns < 24) ? columns : 24, _level, _peak);
+  bands(24, _ring, NULL);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Group log magnitudes (from process()) into logarithmically-
+            spaced bands, i.e. each octave gets a similar number of bands,
+            and apply falloff.
+    @param  n       Number of bands, up to 24.
+    @param  levels  Array of n uint8_t band levels, updated.
+    @param  peaks   Array of n uint8_t peak levels, updated, or NULL.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_Spectrum::bands(uint8_t n, uint8_t *levels,
+                                         uint8_t *peaks) {
+  uint8_t lo = 1; // Skip bin 0 (DC offset)
+  for (uint8_t band = 0; band < n; band++) {
+    // Upper edge is 2^(6 * (band + 1) / n), from 1 to 64 bins. log2 is
+    // 8.8 fixed-point, then linear between powers of 2 (close enough).
+    uint16_t f = (uint16_t)(band + 1) * (6 * 256) / n;
+    uint8_t hi = ((256 + (f & 0xFF)) << (f >> 8)) >> 8;
+    // Low bands would be narrower than 1 bin, those just go up by 1
+    if (hi <= lo)
+      hi = lo + 1;
+    if ((hi > IS3741_SPECTRUM_SAMPLES / 2) || (band == (n - 1)))
+      hi = IS3741_SPECTRUM_SAMPLES / 2;
+    uint8_t m = 0;
+    for (; lo < hi; lo++) { // Loudest bin in band
+      if (_re[lo] > m)
+        m = _re[lo];
+    }
+    // Map to 0-255 using floor & ceiling, then drop old bars gradually
+    uint8_t v = 0;
+    if (m >= _ceiling)
+      v = 255;
+    else if (m > _floor)
+      v = (uint16_t)(m - _floor) * 255 / (_ceiling - _floor);
+    int16_t fall = levels[band] - _barDecay;
+    levels[band] = (v > fall) ? v : fall;
+    if (peaks) {
+      fall = peaks[band] - _peakDecay;
+      peaks[band] = (v > fall) ? v : fall;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw spectrum on matrix, one bar per column (lowest frequencies
+            at left, up to 24 columns), rising from bottom and shading
+            from green to red, with white peak markers. Overwrites the
+            whole matrix. No immediate effect on LEDs; must follow up with
+            show().
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_Spectrum::render(void) {
+  int16_t w = _display->width(), h = _display->height();
+  uint8_t *ledbuf = _display->getBuffer();
+  for (int16_t x = 0; x < w; x++) {
+    // Bar and peak height in 1/256 pixel units
+    uint16_t bar = 0, peak = 0;
+    if (x < 24) {
+      bar = ((uint32_t)_level[x] * h * 256) / 255;
+      peak = ((uint32_t)_peak[x] * h * 256) / 255;
+    }
+    for (int16_t row = 0; row < h; row++) { // Row 0 is bottom
+      uint16_t base = row * 256;
+      uint32_t color = 0;
+      if (peak && ((peak - 1) >> 8) == row) {
+        color = 0xFFFFFF; // Peak marker
+      } else if (bar > base) {
+        uint16_t brightness = (bar >= base + 256) ? 256 : bar - base;
+        uint32_t hue = (h > 1) ? 21845 - 21845UL * row / (h - 1) : 0;
+        color = _display->ColorHSV(hue);
+        _IS31_SCALE_RGB_(color, r, g, b, brightness);
+        color = _display->Color(r, g, b);
+      }
+      uint16_t idx[3];
+      if (_display->getLEDIndices(x, h - 1 - row, idx)) {
+        ledbuf[idx[0]] = color >> 16;
+        ledbuf[idx[1]] = color >> 8;
+        ledbuf[idx[2]] = color;
+      }
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Draw spectrum on an EyeLights ring, 24 bands around the circle
+            as brightness, each a different hue. Ring brightness setting
+            applies. No immediate effect on LEDs; must follow up with
+            show().
+    @param  ring  Pointer to ring, e.g. &glasses.left_ring.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_Spectrum::render(
+    Adafruit_EyeLights_Ring_buffered *ring) {
+  for (uint8_t n = 0; n < 24; n++) {
+    ring->setPixelColor(n, _display->ColorHSV(n * (65536 / 24), 255,
+                                              _display->gamma8(_ring[n])));
+  }
+}
+
+// TRIPLE BUFFERING --------------------------------------------------------
+// Three frames: the newest published one, one being sent (if any), and a
+// free one for the next publish(). Each shared variable has exactly one
+// writer, and only single-byte loads & stores plus barriers are used, no
+// atomic read-modify-write ops (which Cortex-M0+ cores like RP2040 lack).
+// The drawing side picks a frame that's neither newest nor being sent.
+// The sending side marks the newest frame as in use, then checks it's
+// still newest; if not, the drawing side may not have seen the mark in
+// time, so it tries again with the newer one.
+
+/**************************************************************************/
+/*!
+    @brief  Constructor for triple buffer.
+    @param  display  Pointer to buffered object that drawing goes to (e.g.
+                     Adafruit_IS31FL3741_QT_buffered or
+                     Adafruit_EyeLights_buffered).
+*/
+/**************************************************************************/
+Adafruit_IS31FL3741_TripleBuffer::Adafruit_IS31FL3741_TripleBuffer(
+    Adafruit_IS31FL3741_buffered *display)
+    : _display(display), _latest(0), _reading(3), _sent(0) {
+  memset(_frame, 0, sizeof _frame);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Snapshot the buffered object's LEDs as the newest frame for
+            show() to send. Call from drawing core when a frame is done.
+            Never waits on the sending side.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_TripleBuffer::publish(void) {
+  uint8_t latest = _latest & 3, reading = _reading, f = 0;
+  while ((f == latest) || (f == reading)) // Find a free frame,
+    f++;                                  // at most 2 are in use
+  memcpy(&_frame[f][1], _display->getBuffer(), 351);
+  _IS31_MEMORY_BARRIER(); // Frame contents complete before publishing,
+  _latest = (++_seq << 2) | f;
+  _IS31_MEMORY_BARRIER(); // and published before next check of _reading
+}
+
+/**************************************************************************/
+/*!
+    @brief    Send newest published frame to the LED driver, if there's
+              one that hasn't already been sent. Call from sending core.
+    @returns  bool  true if a frame was sent, false if nothing new.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741_TripleBuffer::show(void) {
+  uint8_t latest;
+  do {
+    latest = _latest;
+    if (latest == _sent)
+      return false;
+    _reading = latest & 3; // Claim frame, then make sure it's still newest
+    _IS31_MEMORY_BARRIER();
+  } while (_latest != latest);
+  _display->writeBuffer(_frame[latest & 3]);
+  _sent = latest;
+  _IS31_MEMORY_BARRIER(); // Done reading before releasing frame
+  _reading = 3;
+  return true;
+}
+
+// DELTA UPDATES -----------------------------------------------------------
+// Blocks follow writeBlocks(): 16 bytes each, each page starting a new
+// block, so bits 0-11 cover page 0 (180 bytes) and 12-22 page 1 (171).
+
+/**************************************************************************/
+/*!
+    @brief  Constructor for delta updater. First show() sends everything.
+    @param  display  Pointer to buffered object that drawing goes to (e.g.
+                     Adafruit_IS31FL3741_QT_buffered or
+                     Adafruit_EyeLights_buffered).
+*/
+/**************************************************************************/
+Adafruit_IS31FL3741_DeltaShow::Adafruit_IS31FL3741_DeltaShow(
+    Adafruit_IS31FL3741_buffered *display)
+    : _display(display) {}
+
+/**************************************************************************/
+/*!
+    @brief    Send any 16-byte blocks of the buffered object's LEDs that
+              differ from what was last sent, merging adjacent blocks into
+              single I2C writes. Use in place of the object's show().
+    @returns  bool  true if anything was sent, false if nothing changed.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741_DeltaShow::show(void) {
+  const uint8_t *buf = _display->getBuffer();
+  uint32_t mask = 0;
+  _shownGen = _gen; // Before comparing, so later touches aren't lost
+  _blocks = 0;
+  for (uint8_t b = 0; b < 23; b++) {
+    uint16_t start = (b < 12) ? (b * 16) : (180 + (b - 12) * 16);
+    uint16_t end = (b < 12) ? 180 : 351;
+    uint8_t len = ((end - start) < 16) ? (end - start) : 16;
+    if (!_valid || memcmp(&buf[start], &_sent[start], len)) {
+      memcpy(&_sent[start], &buf[start], len);
+      mask |= (uint32_t)1 << b;
+      _blocks++;
+    }
+  }
+  _valid = true;
+  if (mask)
+    _display->writeBlocks(mask);
+  return mask != 0;
+}
+
+// FRAME PACING ------------------------------------------------------------
+
+/**************************************************************************/
+/*!
+    @brief  Constructor for frame pacer.
+    @param  display  Pointer to buffered object to show (e.g.
+                     Adafruit_IS31FL3741_QT_buffered or
+                     Adafruit_EyeLights_buffered).
+    @param  fps      Target frame rate, frames per second.
+*/
+/**************************************************************************/
+Adafruit_IS31FL3741_FramePacer::Adafruit_IS31FL3741_FramePacer(
+    Adafruit_IS31FL3741_buffered *display, uint16_t fps)
+    : _display(display) {
+  setFPS(fps);
+  reset();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Change the target frame rate. Takes effect after the current
+            frame.
+    @param  fps  Frames per second (1 or higher).
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_FramePacer::setFPS(uint16_t fps) {
+  _period = 1000000UL / (fps ? fps : 1);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Clear statistics and restart the schedule with the next show(),
+            e.g. after a pause in animation. The first frame after this has
+            no drawing time to measure.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_FramePacer::reset(void) {
+  memset(&_stats, 0, sizeof _stats);
+  _renderSum = _showSum = 0;
+  _count = 0;
+  _running = false;
+  _quality = IS3741_QUALITY_LEVELS - 1;
+  _upFrames = 60;
+  _sinceUp = 65535; // No recent step up
+  _under = 0;
+  _over = _holdoff = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Enable or disable adaptive quality. When on, show() watches
+            the averaged drawing + transfer time, stepping getQuality()
+            down when frames run over budget and back up after a while
+            with time to spare. The sketch decides what each level means,
+            or uses the allow*() functions for a standard ladder: one step
+            down switches to the cheaper scale(), two skips interpolated
+            frames, three and up halve the ring refresh rate each step.
+    @param  on  true to enable, false to disable (returns to full quality).
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_FramePacer::setAdaptive(bool on) {
+  _adaptive = on;
+  if (!on)
+    _quality = IS3741_QUALITY_LEVELS - 1;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Check whether this frame can afford a smooth (3x3 averaged)
+              EyeLights scale(), e.g. glasses.scale(pacer.allowSmoothScale()).
+    @returns  bool  true at full quality, false at any reduced level.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741_FramePacer::allowSmoothScale(void) const {
+  return _quality >= (IS3741_QUALITY_LEVELS - 1);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Check whether a sketch that renders in-between (interpolated
+              or tweened) frames should do so.
+    @returns  bool  true unless quality is two or more steps down.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741_FramePacer::allowInterpolatedFrame(void) const {
+  return _quality >= (IS3741_QUALITY_LEVELS - 2);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Check whether EyeLights rings (or any secondary element) are
+              due for redrawing this frame. Rings are usually less
+              noticeable than the matrix, so their rate is reduced.
+    @returns  bool  true every frame until quality is three steps down,
+                    then every 2nd, 4th or 8th frame.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741_FramePacer::allowRingUpdate(void) const {
+  uint8_t drop = IS3741_QUALITY_LEVELS - 1 - _quality;
+  if (drop < 3)
+    return true;
+  uint8_t mask = (1 << (drop - 2)) - 1;
+  return !(_stats.frames & mask);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Adaptive quality policy, called by show() after each frame.
+            Steps down after 3 frames in a row over ~94% of the period (or
+            missed), up after _upFrames in a row under 75%. The gap
+            between thresholds, and a pause after each change to let the
+            averages settle, keep it from reacting to noise. If a step up
+            is soon followed by a step down, that level doesn't really fit,
+            so the wait before trying again is doubled (up to 1920 frames).
+    @param  missed  true if the frame just shown missed its deadline.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_FramePacer::adapt(bool missed) {
+  if (_sinceUp < 65535)
+    _sinceUp++;
+  if (_holdoff) {
+    _holdoff--;
+    return;
+  }
+  uint32_t busy = _stats.renderAvg + _stats.showAvg;
+  if (missed || (busy > (_period - (_period >> 4)))) {
+    _under = 0;
+    if ((++_over >= 3) && _quality) {
+      _quality--;
+      if (_sinceUp < _upFrames) {
+        if (_upFrames < 1920)
+          _upFrames *= 2;
+      } else {
+        _upFrames = 60;
+      }
+      _over = 0;
+      _holdoff = 16;
+    }
+  } else if (busy < ((_period >> 1) + (_period >> 2))) {
+    _over = 0;
+    if ((++_under >= _upFrames) && (_quality < (IS3741_QUALITY_LEVELS - 1))) {
+      _quality++;
+      _under = 0;
+      _sinceUp = 0;
+      _holdoff = 16;
+    }
+  } else {
+    _over = _under = 0;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief    Send the buffered frame to the LED driver, then wait until
+              the next frame is due. Call where a sketch would otherwise
+              call show() and delay(). Drawing time is measured from the
+              prior frame's return to this call, transfer time is the
+              display's show() itself.
+    @returns  bool  true if the frame was on time, false if drawing and
+                    transfer together exceeded the frame period.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741_FramePacer::show(void) {
+  uint32_t t0 = micros();
+  if (!_running) {
+    _start = _second = t0;
+    _running = true;
+  }
+  uint32_t render = t0 - _start;
+  _display->show();
+  uint32_t t1 = micros();
+  uint32_t xfer = t1 - t0;
+
+  _stats.renderUs = render;
+  _stats.showUs = xfer;
+  if (render > _stats.renderMax)
+    _stats.renderMax = render;
+  if (xfer > _stats.showMax)
+    _stats.showMax = xfer;
+  // Running averages are kept at 16X for precision with small values
+  _renderSum += render - (_renderSum >> 4);
+  _showSum += xfer - (_showSum >> 4);
+  _stats.renderAvg = _renderSum >> 4;
+  _stats.showAvg = _showSum >> 4;
+  _stats.frames++;
+  _count++;
+
+  uint32_t target = _start + _period;
+  bool onTime = (int32_t)(target - t1) >= 0;
+  uint32_t late;
+  if (onTime) {
+    // delay() most of the remaining time (allows background tasks on
+    // some cores), then spin on micros() for the last bit, as delay()
+    // alone is only millisecond-accurate.
+    int32_t remain = target - t1;
+    if (remain > 2000)
+      delay((remain - 1000) / 1000);
+    while ((int32_t)(target - micros()) > 0)
+      ;
+    late = micros() - target;
+    _start = target;
+  } else {
+    _stats.missed++;
+    late = t1 - target;
+    _start = t1; // Restart schedule from here, no catch-up burst
+  }
+  if (_adaptive)
+    adapt(!onTime);
+  uint8_t bin = 0;
+  for (late >>= 6; late && (bin < (IS3741_JITTER_BINS - 1)); late >>= 1)
+    bin++;
+  _stats.jitter[bin]++;
+
+  uint32_t elapsed = _start - _second;
+  if (elapsed >= 1000000) {
+    _stats.fps = ((uint32_t)_count * 100000UL + elapsed / 20) / (elapsed / 10);
+    _second = _start;
+    _count = 0;
+  }
+
+  return onTime;
+}
+
+// TRANSACTION TRACING -----------------------------------------------------
+
+// Pack a trace record header (little-endian, 8 bytes) into hdr.
+static void _IS31traceHeader(uint8_t *hdr, uint32_t time, uint8_t addr,
+                             uint8_t flags, uint16_t len) {
+  hdr[0] = time;
+  hdr[1] = time >> 8;
+  hdr[2] = time >> 16;
+  hdr[3] = time >> 24;
+  hdr[4] = addr;
+  hdr[5] = flags;
+  hdr[6] = len;
+  hdr[7] = len >> 8;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Constructor for RAM trace buffer.
+    @param  buf   Pointer to buffer provided by sketch. Each record takes
+                  8 bytes plus data (e.g. 10 for a register write, 41 for
+                  a 32-byte chunk of a buffered show()).
+    @param  size  Size of buf in bytes.
+*/
+/**************************************************************************/
+Adafruit_IS31FL3741_TraceBuffer::Adafruit_IS31FL3741_TraceBuffer(
+    uint8_t *buf, uint16_t size)
+    : _buf(buf), _size(size) {
+  clear();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Discard all records and reset dropped() count.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_TraceBuffer::clear(void) {
+  _head = _used = _records = 0;
+  _dropped = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Read a byte relative to the oldest record, with wraparound.
+    @param    offset  Byte offset from start of oldest record.
+    @returns  uint8_t  Byte value.
+*/
+/**************************************************************************/
+uint8_t Adafruit_IS31FL3741_TraceBuffer::peek(uint16_t offset) const {
+  uint32_t i = (uint32_t)_head + offset;
+  return _buf[(i >= _size) ? (i - _size) : i];
+}
+
+/**************************************************************************/
+/*!
+    @brief  Store one transaction record, discarding oldest records as
+            needed to make room. Called by Adafruit_IS31FL3741, not user
+            code.
+    @param  time   micros() when the transaction started.
+    @param  addr   7-bit I2C address.
+    @param  flags  IS3741_TRACE_READ and/or IS3741_TRACE_FAIL bits.
+    @param  data   Register address followed by values.
+    @param  len    Length of data, including register address.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_TraceBuffer::record(uint32_t time, uint8_t addr,
+                                             uint8_t flags,
+                                             const uint8_t *data,
+                                             uint16_t len) {
+  uint32_t need = 8 + (uint32_t)len;
+  if (need > _size) {
+    _dropped++;
+    return;
+  }
+  while ((uint32_t)(_size - _used) < need) { // Discard oldest to fit
+    uint16_t oldest = 8 + (peek(6) | (peek(7) << 8));
+    _head = ((uint32_t)_head + oldest) % _size;
+    _used -= oldest;
+    _records--;
+    _dropped++;
+  }
+  uint8_t hdr[8];
+  _IS31traceHeader(hdr, time, addr, flags, len);
+  uint32_t tail = ((uint32_t)_head + _used) % _size;
+  for (uint16_t i = 0; i < need; i++) {
+    _buf[tail] = (i < 8) ? hdr[i] : data[i - 8];
+    if (++tail >= _size)
+      tail = 0;
+  }
+  _used += need;
+  _records++;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Write all records, oldest first, in binary trace format, e.g.
+            to an SD card File for later replay. Buffer is not cleared.
+    @param  out  Pointer to Print stream.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_TraceBuffer::dump(Print *out) const {
+  for (uint16_t i = 0; i < _used; i++)
+    out->write(peek(i));
+}
+
+/**************************************************************************/
+/*!
+    @brief  Print all records, oldest first, as readable text, one line
+            per record: time, I2C address, R (read) or W (write), '!' if
+            not acknowledged, then data bytes in hex. Buffer is not
+            cleared.
+    @param  out  Pointer to Print stream, e.g. &Serial.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_TraceBuffer::list(Print *out) const {
+  uint16_t pos = 0;
+  for (uint16_t r = 0; r < _records; r++) {
+    uint32_t time = (uint32_t)peek(pos) | ((uint32_t)peek(pos + 1) << 8) |
+                    ((uint32_t)peek(pos + 2) << 16) |
+                    ((uint32_t)peek(pos + 3) << 24);
+    uint8_t flags = peek(pos + 5);
+    uint16_t len = peek(pos + 6) | (peek(pos + 7) << 8);
+    out->print(time);
+    out->print(F(" 0x"));
+    out->print(peek(pos + 4), HEX);
+    out->print((flags & IS3741_TRACE_READ) ? F(" R") : F(" W"));
+    if (flags & IS3741_TRACE_FAIL)
+      out->print('!');
+    pos += 8;
+    for (uint16_t i = 0; i < len; i++) {
+      uint8_t b = peek(pos++);
+      out->print((b < 0x10) ? F(" 0") : F(" "));
+      out->print(b, HEX);
+    }
+    out->println();
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Write one transaction record to the Print stream. Called by
+            Adafruit_IS31FL3741, not user code.
+    @param  time   micros() when the transaction started.
+    @param  addr   7-bit I2C address.
+    @param  flags  IS3741_TRACE_READ and/or IS3741_TRACE_FAIL bits.
+    @param  data   Register address followed by values.
+    @param  len    Length of data, including register address.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_TracePrint::record(uint32_t time, uint8_t addr,
+                                            uint8_t flags, const uint8_t *data,
+                                            uint16_t len) {
+  uint8_t hdr[8];
+  _IS31traceHeader(hdr, time, addr, flags, len);
+  _out->write(hdr, 8);
+  _out->write(data, len);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Return model to the chip's power-on state: all registers zero
+            (LEDs off, software shutdown), no page selected, command
+            register locked. Error count is cleared.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_Model::reset(void) {
+  resetRegisters();
+  _page = -1;
+  _unlocked = false;
+  _errors = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Zero PWM, scaling and function registers, as a chip does at
+            power-on or on a software reset via register 0x3F.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_Model::resetRegisters(void) {
+  memset(_pwm, 0, sizeof _pwm);
+  memset(_scaling, 0, sizeof _scaling);
+  memset(_func, 0, sizeof _func);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Apply one transaction record to the modeled chip state. Reads
+            and unacknowledged writes have no effect. Called by
+            Adafruit_IS31FL3741 or TraceReplay, not user code.
+    @param  time   micros() when the transaction started (unused).
+    @param  addr   7-bit I2C address (unused; one chip is modeled).
+    @param  flags  IS3741_TRACE_READ and/or IS3741_TRACE_FAIL bits.
+    @param  data   Register address followed by values.
+    @param  len    Length of data, including register address.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_Model::record(uint32_t time, uint8_t addr,
+                                       uint8_t flags, const uint8_t *data,
+                                       uint16_t len) {
+  (void)time;
+  (void)addr;
+  if ((flags & (IS3741_TRACE_READ | IS3741_TRACE_FAIL)) || (len < 2))
+    return;
+
+  uint8_t reg = data[0];
+  if (reg == IS3741_COMMANDREGISTERLOCK) {
+    _unlocked = (data[1] == 0xC5);
+  } else if (reg == IS3741_COMMANDREGISTER) {
+    // Page select takes effect only if unlocked; relocks either way
+    if (_unlocked && (data[1] < 5))
+      _page = data[1];
+    else
+      _errors++;
+    _unlocked = false;
+  } else if (reg < IS3741_INTMASKREGISTER) {
+    // Register writes auto-increment within the selected page
+    for (uint16_t i = 1; i < len; i++, reg++) {
+      uint8_t value = data[i];
+      switch (_page) {
+      case 0:
+      case 2:
+        if (reg < 180)
+          ((_page == 0) ? _pwm : _scaling)[reg] = value;
+        else
+          _errors++;
+        break;
+      case 1:
+      case 3:
+        if (reg < 171)
+          ((_page == 1) ? _pwm : _scaling)[180 + reg] = value;
+        else
+          _errors++;
+        break;
+      case 4:
+        if (reg == IS3741_FUNCREG_RESET) {
+          if (value == 0xAE)
+            resetRegisters();
+        } else if (reg < sizeof _func) {
+          _func[reg] = value;
+        } else {
+          _errors++;
+        }
+        break;
+      default: // No page selected
+        _errors++;
+        break;
+      }
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief    Get modeled PWM level of one LED.
+    @param    lednum  LED index, 0-350.
+    @returns  uint8_t  PWM value, 0 if index out of range.
+*/
+/**************************************************************************/
+uint8_t Adafruit_IS31FL3741_Model::getPWM(uint16_t lednum) const {
+  return (lednum < 351) ? _pwm[lednum] : 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Get modeled scaling level of one LED.
+    @param    lednum  LED index, 0-350.
+    @returns  uint8_t  Scaling value, 0 if index out of range.
+*/
+/**************************************************************************/
+uint8_t Adafruit_IS31FL3741_Model::getScaling(uint16_t lednum) const {
+  return (lednum < 351) ? _scaling[lednum] : 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Get modeled value of a page 4 function register, e.g.
+              IS3741_FUNCREG_CONFIG or IS3741_FUNCREG_GCURRENT.
+    @param    reg  Register address.
+    @returns  uint8_t  Register value, 0 if out of range.
+*/
+/**************************************************************************/
+uint8_t Adafruit_IS31FL3741_Model::getRegister(uint8_t reg) const {
+  return (reg < sizeof _func) ? _func[reg] : 0;
+}
+
+// Bus timing model, in I2C bit times. START is about one bit time; STOP
+// plus the required bus-free time before the next START is about two.
+// Each byte is 8 bits plus ACK.
+#define _IS31_I2C_START_BITS 1
+#define _IS31_I2C_STOP_BITS 2
+#define _IS31_I2C_BYTE_BITS 9
+
+/**************************************************************************/
+/*!
+    @brief  Constructor for bus timing model.
+    @param  clock       I2C clock rate to model, Hz.
+    @param  bufferSize  I2C driver buffer size to model (as returned by
+                        maxBufferSize(); 32 on AVR & SAMD, larger on some
+                        other platforms). Writes in a trace longer than
+                        this are costed as if split into chunks.
+*/
+/**************************************************************************/
+Adafruit_IS31FL3741_BusModel::Adafruit_IS31FL3741_BusModel(uint32_t clock,
+                                                           uint16_t bufferSize)
+    : _clock(clock), _bufferSize(bufferSize) {
+  reset();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Clear all totals, e.g. before tracing one frame.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_BusModel::reset(void) {
+  _bits = _pageBits = 0;
+  _transactions = _pageSelects = _bytes = 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Add one transaction's cost to totals. Called by
+            Adafruit_IS31FL3741 or TraceReplay, not user code.
+    @param  time   micros() when the transaction started (unused, model
+                   computes its own timing).
+    @param  addr   7-bit I2C address (unused).
+    @param  flags  IS3741_TRACE_READ and/or IS3741_TRACE_FAIL bits.
+                   Failed transactions are costed as complete, as this
+                   is for predicting.
+    @param  data   Register address followed by values.
+    @param  len    Length of data, including register address.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_BusModel::record(uint32_t time, uint8_t addr,
+                                          uint8_t flags, const uint8_t *data,
+                                          uint16_t len) {
+  (void)time;
+  (void)addr;
+  if (!len)
+    return;
+  if (flags & IS3741_TRACE_READ) {
+    _bits += readBits(len - 1);
+    _transactions++;
+    _bytes += len;
+  } else {
+    uint32_t bits = writeBits(len, _bufferSize);
+    uint16_t chunk = (_bufferSize > 1) ? (_bufferSize - 1) : 1;
+    uint16_t n = (len > 1) ? ((len - 2) / chunk + 1) : 1;
+    _bits += bits;
+    _transactions += n;
+    _bytes += len + n - 1; // Each split chunk repeats register address
+    if ((data[0] == IS3741_COMMANDREGISTER) ||
+        (data[0] == IS3741_COMMANDREGISTERLOCK)) {
+      _pageBits += bits;
+      if (data[0] == IS3741_COMMANDREGISTER)
+        _pageSelects++;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief    Get predicted total bus time since reset().
+    @returns  uint32_t  Microseconds, including per-transaction overhead.
+*/
+/**************************************************************************/
+uint32_t Adafruit_IS31FL3741_BusModel::busMicros(void) const {
+  return bitsToMicros(_bits, _clock) + _transactions * _overhead;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Get the part of busMicros() spent on page selects, to judge
+              whether a transfer strategy switches pages too often.
+    @returns  uint32_t  Microseconds, including per-transaction overhead.
+*/
+/**************************************************************************/
+uint32_t Adafruit_IS31FL3741_BusModel::pageMicros(void) const {
+  return bitsToMicros(_pageBits, _clock) + _pageSelects * 2 * _overhead;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Bit times to write to consecutive registers, split into as
+              many transactions as the buffer size requires.
+    @param    len         Register address + data bytes.
+    @param    bufferSize  I2C driver buffer size (register address + data
+                          per transaction).
+    @returns  uint32_t  I2C bit times.
+*/
+/**************************************************************************/
+uint32_t Adafruit_IS31FL3741_BusModel::writeBits(uint16_t len,
+                                                 uint16_t bufferSize) {
+  if (!len)
+    return 0;
+  uint16_t chunk = (bufferSize > 1) ? (bufferSize - 1) : 1;
+  uint16_t n = (len > 1) ? ((len - 2) / chunk + 1) : 1; // Transactions
+  return (uint32_t)n * (_IS31_I2C_START_BITS + _IS31_I2C_BYTE_BITS * 2 +
+                        _IS31_I2C_STOP_BITS) +
+         (uint32_t)(len - 1) * _IS31_I2C_BYTE_BITS;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Bit times to read consecutive registers: write register
+              address, repeated START, read data.
+    @param    len  Number of bytes read.
+    @returns  uint32_t  I2C bit times.
+*/
+/**************************************************************************/
+uint32_t Adafruit_IS31FL3741_BusModel::readBits(uint16_t len) {
+  return _IS31_I2C_START_BITS * 2 + _IS31_I2C_BYTE_BITS * 3 +
+         (uint32_t)len * _IS31_I2C_BYTE_BITS + _IS31_I2C_STOP_BITS;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Convert I2C bit times to microseconds at a given clock rate.
+    @param    bits   Bit times.
+    @param    clock  I2C clock, Hz.
+    @returns  uint32_t  Microseconds, rounded.
+*/
+/**************************************************************************/
+uint32_t Adafruit_IS31FL3741_BusModel::bitsToMicros(uint32_t bits,
+                                                    uint32_t clock) {
+  return ((uint64_t)bits * 1000000 + clock / 2) / clock;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Predict bus time of a buffered show(): page select, 180 bytes
+              to page 0, page select, 171 bytes to page 1.
+    @param    clock       I2C clock, Hz.
+    @param    bufferSize  I2C driver buffer size (maxBufferSize()).
+    @returns  uint32_t  Microseconds.
+*/
+/**************************************************************************/
+uint32_t Adafruit_IS31FL3741_BusModel::predictShow(uint32_t clock,
+                                                   uint16_t bufferSize) {
+  uint32_t bits = writeBits(2) * 4 + // Two unlock + page select pairs
+                  writeBits(1 + 180, bufferSize) +
+                  writeBits(1 + 171, bufferSize);
+  return bitsToMicros(bits, clock);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Predict bus time of fill() (or setLEDscaling() for all LEDs),
+              which always uses 32-byte transfers regardless of platform.
+    @param    clock  I2C clock, Hz.
+    @returns  uint32_t  Microseconds.
+*/
+/**************************************************************************/
+uint32_t Adafruit_IS31FL3741_BusModel::predictFill(uint32_t clock) {
+  uint32_t bits =
+      writeBits(2) * 4 + writeBits(1 + 180, 32) + writeBits(1 + 171, 32);
+  return bitsToMicros(bits, clock);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Predict bus time of setting RGB pixels one at a time on an
+              unbuffered (direct) object, e.g. drawPixel(): three 2-byte
+              register writes each. Page selects are not included, as
+              those depend on drawing order; each page change adds
+              writeBits(2) * 2.
+    @param    clock  I2C clock, Hz.
+    @param    n      Number of pixels.
+    @returns  uint32_t  Microseconds.
+*/
+/**************************************************************************/
+uint32_t Adafruit_IS31FL3741_BusModel::predictPixels(uint32_t clock,
+                                                     uint16_t n) {
+  return bitsToMicros(writeBits(2) * 3 * (uint32_t)n, clock);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Read bytes from input stream, waiting per its setTimeout().
+    @param    buf  Destination, or NULL to discard.
+    @param    len  Number of bytes.
+    @returns  bool  true if all bytes were read, false on timeout or end.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741_TraceReplay::readBytes(uint8_t *buf, uint16_t len) {
+  uint8_t scratch;
+  for (uint16_t i = 0; i < len; i++) {
+    uint8_t *dst = buf ? &buf[i] : &scratch;
+    if (_in->readBytes(dst, 1) != 1)
+      return false;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Read the next record from the input stream. Its contents are
+              then available through time(), address(), flags(), data()
+              and length(). Data past 256 bytes, if any, is skipped.
+    @returns  bool  true if a complete record was read, false at end of
+                    stream (or on a truncated record).
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741_TraceReplay::next(void) {
+  uint8_t hdr[8];
+  if (!readBytes(hdr, 8))
+    return false;
+  _time = (uint32_t)hdr[0] | ((uint32_t)hdr[1] << 8) |
+          ((uint32_t)hdr[2] << 16) | ((uint32_t)hdr[3] << 24);
+  _addr = hdr[4];
+  _flags = hdr[5];
+  uint16_t len = hdr[6] | (hdr[7] << 8);
+  _len = (len > sizeof _data) ? sizeof _data : len;
+  return readBytes(_data, _len) && readBytes(NULL, len - _len);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Play all remaining records onto a real chip. Writes are sent
+              as recorded (including page selects), reads are skipped.
+              The chip object must have had begin() called; its address
+              is used rather than the one recorded.
+    @param    chip      Pointer to any Adafruit_IS31FL3741 (or subclass)
+                        object.
+    @param    realtime  If true, wait between writes to match the original
+                        timing, to reproduce glitches that depend on it.
+    @returns  uint32_t  Number of writes sent.
+*/
+/**************************************************************************/
+uint32_t Adafruit_IS31FL3741_TraceReplay::replay(Adafruit_IS31FL3741 *chip,
+                                                 bool realtime) {
+  uint32_t count = 0, start = 0, first = 0;
+  while (next()) {
+    if (_flags & IS3741_TRACE_READ)
+      continue;
+    if (realtime) {
+      if (!count) {
+        start = micros();
+        first = _time;
+      } else {
+        while ((micros() - start) < (_time - first))
+          ;
+      }
+    }
+    chip->writeRaw(_data, _len);
+    count++;
+  }
+  return count;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Pass all remaining records to a trace sink, e.g. an
+              Adafruit_IS31FL3741_Model to reproduce chip state offline.
+    @param    sink  Pointer to any Adafruit_IS31FL3741_TraceSink subclass.
+    @returns  uint32_t  Number of records passed.
+*/
+/**************************************************************************/
+uint32_t
+Adafruit_IS31FL3741_TraceReplay::replay(Adafruit_IS31FL3741_TraceSink *sink) {
+  uint32_t count = 0;
+  while (next()) {
+    sink->record(_time, _addr, _flags, _data, _len);
+    count++;
+  }
+  return count;
+}
+
+// DMX OVER NETWORK (ART-NET, E1.31) ---------------------------------------
+// Only the packet fields needed here are checked. Art-Net ArtDmx: ID at 0,
+// opcode 0x5000 (little-endian) at 8, sequence at 12, 15-bit port-address
+// (little-endian) at 14, big-endian length at 16, data from 18. ArtSync is
+// opcode 0x5200. E1.31: ID at 4, big-endian root layer vector at 18 (4 =
+// data, 8 = sync) and framing layer vector at 40 (2 = data, 1 = sync).
+// Data packets then have sequence at 111, options at 112, universe at 113,
+// value count (including start code) at 123, start code at 125, data from
+// 126. All E1.31 multi-byte values are big-endian.
+
+#define _IS31_DMX_SYNC_TIMEOUT 4000 // ms w/o sync packets to stop waiting
+
+static const uint8_t PROGMEM _IS31ArtNetID[8] = {'A', 'r', 't', '-',
+                                                 'N', 'e', 't', 0};
+static const uint8_t PROGMEM _IS31E131ID[12] = {
+    'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0};
+
+// Compare len bytes of RAM against PROGMEM, true if equal.
+static bool _IS31match(const uint8_t *data, const uint8_t *id, uint8_t len) {
+  while (len--) {
+    if (*data++ != pgm_read_byte(id++))
+      return false;
+  }
+  return true;
+}
+
+// Big-endian 16- and 32-bit fetch from packet data.
+static uint16_t _IS31be16(const uint8_t *p) { return (p[0] << 8) | p[1]; }
+static uint32_t _IS31be32(const uint8_t *p) {
+  return ((uint32_t)_IS31be16(p) << 16) | _IS31be16(&p[2]);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Constructor for DMX receiver.
+    @param  map    Array of IS3741_dmxMap mapping entries, which must
+                   persist (e.g. global or const) for the life of this
+                   object. Several entries may use the same universe (e.g.
+                   split across objects) or the same object (e.g. several
+                   universes into one).
+    @param  count  Number of entries in map, up to IS3741_DMX_MAPS.
+*/
+/**************************************************************************/
+Adafruit_IS31FL3741_DMX::Adafruit_IS31FL3741_DMX(const IS3741_dmxMap *map,
+                                                 uint8_t count)
+    : _map(map), _count(min(count, (uint8_t)IS3741_DMX_MAPS)) {
+  memset(_seq, 0, sizeof _seq);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Process one received UDP packet. Art-Net ArtDmx and ArtSync,
+              and E1.31 data and sync packets are recognized, anything else
+              (including E1.31 preview data) is ignored. Sketch should call
+              this for every packet arriving on IS3741_ARTNET_PORT or
+              IS3741_E131_PORT (multicast group joining for E1.31, if
+              wanted, is also up to the sketch).
+    @param    data  Packet contents.
+    @param    len   Packet length in bytes.
+    @returns  uint8_t  Number of objects whose show() was called.
+*/
+/**************************************************************************/
+uint8_t Adafruit_IS31FL3741_DMX::handlePacket(const uint8_t *data,
+                                              uint16_t len) {
+  if ((len >= 10) && _IS31match(data, _IS31ArtNetID, 8)) {
+    uint16_t op = data[8] | (data[9] << 8);
+    if ((op == 0x5000) && (len >= 18)) {
+      uint16_t n = min(_IS31be16(&data[16]), (uint16_t)(len - 18));
+      int16_t seq = data[12] ? data[12] : -1; // 0 = unsequenced
+      return receive(((data[15] & 0x7F) << 8) | data[14], seq, &data[18], n);
+    }
+    if (op == 0x5200)
+      return sync();
+  } else if ((len >= 44) && _IS31match(&data[4], _IS31E131ID, 12)) {
+    uint32_t root = _IS31be32(&data[18]), framing = _IS31be32(&data[40]);
+    if ((root == 4) && (framing == 2) && (len >= 126) &&
+        !(data[112] & 0xC0) && !data[125]) { // Not preview/end, DMX start
+      uint16_t n = _IS31be16(&data[123]);
+      n = n ? min((uint16_t)(n - 1), (uint16_t)(len - 126)) : 0;
+      return receive(_IS31be16(&data[113]), data[111], &data[126], n);
+    }
+    if ((root == 8) && (framing == 1))
+      return sync();
+  }
+  return 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Call show() on every object that has received any DMX data
+              since its last show(), even if universes are missing. Not
+              normally needed, but a sketch could call this if no packets
+              arrive for a while, to not leave a partial frame unshown.
+    @returns  uint8_t  Number of objects whose show() was called.
+*/
+/**************************************************************************/
+uint8_t Adafruit_IS31FL3741_DMX::commit(void) {
+  return showFrames(0xFFFF, true);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Copy one universe of DMX data into every mapping entry that
+              uses it, then show any object whose frame is now complete.
+              A universe arriving again before its object was shown means
+              others went missing, so that partial frame is shown first.
+    @param    universe  Universe number.
+    @param    seq       Packet sequence number 0-255, or -1 if none.
+    @param    dmx       DMX channel data, starting with channel 1.
+    @param    len       Number of channels.
+    @returns  uint8_t  Number of objects whose show() was called.
+*/
+/**************************************************************************/
+uint8_t Adafruit_IS31FL3741_DMX::receive(uint16_t universe, int16_t seq,
+                                         const uint8_t *dmx, uint16_t len) {
+  uint8_t shown = 0;
+  bool matched = false, accepted = false;
+
+  if (_synced && ((millis() - _lastSync) > _IS31_DMX_SYNC_TIMEOUT))
+    _synced = false; // Sender stopped syncing, show as frames complete
+
+  for (uint8_t i = 0; i < _count; i++) {
+    const IS3741_dmxMap *m = &_map[i];
+    if (m->universe != universe)
+      continue;
+    matched = true;
+    uint16_t bit = 1 << i;
+    if ((seq >= 0) && (_seen & bit)) {
+      // Same rule as E1.31: up to 19 behind (or equal) is late, drop it.
+      // Anything else is newer, or a sender restart after a long gap.
+      int8_t diff = seq - _seq[i];
+      if ((diff <= 0) && (diff > -20))
+        continue;
+    }
+    _seq[i] = seq;
+    _seen |= bit;
+    if (_received & bit) // Previous frame incomplete, show what there is
+      shown += showFrames(bit, true);
+    uint16_t ch = m->channel - 1;
+    if ((ch < len) && (m->offset < 351)) {
+      uint16_t n = min(m->count, (uint16_t)(len - ch));
+      n = min(n, (uint16_t)(351 - m->offset));
+      memcpy(&m->display->getBuffer()[m->offset], &dmx[ch], n);
+    }
+    _received |= bit;
+    accepted = true;
+  }
+
+  if (accepted)
+    _packets++;
+  else if (matched)
+    _dropped++;
+  if (!_synced)
+    shown += showFrames(0xFFFF, false);
+  return shown;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Handle a sync packet: show everything received so far, and
+              from now on show only on sync, until syncs stop for a while.
+    @returns  uint8_t  Number of objects whose show() was called.
+*/
+/**************************************************************************/
+uint8_t Adafruit_IS31FL3741_DMX::sync(void) {
+  _synced = true;
+  _lastSync = millis();
+  return showFrames(0xFFFF, true);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Call show() once on each object having mapping entries in
+              mask that have received data.
+    @param    mask  Bit mask of mapping entries to consider.
+    @param    all   If true, show partial frames too. If false, only show
+                    objects whose every entry has received data.
+    @returns  uint8_t  Number of objects whose show() was called.
+*/
+/**************************************************************************/
+uint8_t Adafruit_IS31FL3741_DMX::showFrames(uint16_t mask, bool all) {
+  uint8_t shown = 0;
+  for (uint8_t i = 0; i < _count; i++) {
+    uint16_t g = group(i);
+    if (!(mask & g & _received))
+      continue; // Nothing new for this object (or already shown)
+    bool complete = ((_received & g) == g);
+    if (complete || all) {
+      _map[i].display->show();
+      _received &= ~g;
+      _frames++;
+      if (!complete)
+        _partial++;
+      shown++;
+    }
+  }
+  return shown;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Find all mapping entries writing the same object as one entry.
+    @param    i  Mapping entry index.
+    @returns  uint16_t  Bit mask of entries sharing that entry's object.
+*/
+/**************************************************************************/
+uint16_t Adafruit_IS31FL3741_DMX::group(uint8_t i) const {
+  uint16_t mask = 0;
+  for (uint8_t j = 0; j < _count; j++) {
+    if (_map[j].display == _map[i].display)
+      mask |= 1 << j;
+  }
+  return mask;
+}
+
+// SERIAL FRAME PROTOCOL ---------------------------------------------------
+// Parser states: 0-1 sync bytes, 2 type, 3-4 length, 5 payload, 6-7
+// checksum. Any unexpected byte returns to state 0 to hunt for sync.
+
+/**************************************************************************/
+/*!
+    @brief  Constructor for serial frame receiver.
+    @param  display  Pointer to buffered matrix object (e.g.
+                     Adafruit_IS31FL3741_QT_buffered or
+                     Adafruit_EyeLights_buffered) to draw into.
+    @param  in       Stream messages arrive on, e.g. &Serial. Must be
+                     started (e.g. Serial.begin()) by the sketch.
+*/
+/**************************************************************************/
+Adafruit_IS31FL3741_FrameReceiver::Adafruit_IS31FL3741_FrameReceiver(
+    Adafruit_IS31FL3741_colorGFX_buffered *display, Stream *in)
+    : _display(display), _in(in) {}
+
+/**************************************************************************/
+/*!
+    @brief    Process all bytes waiting on the input stream. Call often,
+              e.g. every pass through loop(); never waits for more data.
+    @returns  uint8_t  Number of messages completed that called show().
+*/
+/**************************************************************************/
+uint8_t Adafruit_IS31FL3741_FrameReceiver::poll(void) {
+  uint8_t buf[32], shown = 0;
+  int n;
+  while ((n = _in->available()) > 0) {
+    n = _in->readBytes(buf, min(n, (int)sizeof buf));
+    for (int i = 0; i < n; i++)
+      shown += parse(buf[i]);
+  }
+  return shown;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Advance the parser by one received byte.
+    @param    c  Byte received.
+    @returns  uint8_t  1 if this completed a message that called show(),
+                       else 0.
+*/
+/**************************************************************************/
+uint8_t Adafruit_IS31FL3741_FrameReceiver::parse(uint8_t c) {
+  if ((_state >= 2) && (_state <= 5)) { // Checksummed part
+    uint16_t s = _sum1 + c;
+    _sum1 = (s >= 255) ? (s - 255) : s;
+    s = _sum2 + _sum1;
+    _sum2 = (s >= 255) ? (s - 255) : s;
+  }
+  switch (_state) {
+  case 0:
+    if (c == 'I')
+      _state = 1;
+    break;
+  case 1:
+    _state = (c == 'S') ? 2 : (c == 'I') ? 1 : 0;
+    _sum1 = _sum2 = 0; // Sums start with next byte (type)
+    break;
+  case 2:
+    _type = c;
+    _state = 3;
+    break;
+  case 3:
+    _len = c;
+    _state = 4;
+    break;
+  case 4:
+    _len |= c << 8;
+    if (start()) {
+      _state = _len ? 5 : 6;
+    } else {
+      reply(false);
+      _state = 0;
+    }
+    break;
+  case 5:
+    payload(c);
+    if (++_pos >= _len)
+      _state = 6;
+    break;
+  case 6:
+    _check = c;
+    _state = 7;
+    break;
+  case 7:
+    _state = 0;
+    if ((_check == _sum1) && (c == _sum2)) {
+      reply(true);
+      if (_type != IS3741_FRAME_PALETTE) {
+        _display->show();
+        return 1;
+      }
+    } else {
+      reply(false);
+    }
+    break;
+  }
+  return 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Check type and length of a new message, and set up to
+              receive its payload.
+    @returns  bool  true if message is valid, false to reject it.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741_FrameReceiver::start(void) {
+  _pos = _arg = _sub = 0;
+  switch (_type) {
+  case IS3741_FRAME_FULL:
+    return _len == 351;
+  case IS3741_FRAME_DELTA:
+    return true;
+  case IS3741_FRAME_PALETTE:
+    return _len >= 1;
+  case IS3741_FRAME_INDEXED:
+    return _len == (_display->width() * _display->height() + 1) / 2;
+  }
+  return false;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Decode one payload byte of current message into the LED buffer
+            or palette.
+    @param  c  Payload byte.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_FrameReceiver::payload(uint8_t c) {
+  uint8_t *buf = _display->getBuffer();
+  switch (_type) {
+  case IS3741_FRAME_FULL:
+    buf[_pos] = c;
+    break;
+  case IS3741_FRAME_DELTA:
+    switch (_sub) {
+    case 0: // Run index, low byte
+      _arg = c;
+      _sub = 1;
+      break;
+    case 1: // Run index, high byte
+      _arg |= c << 8;
+      _sub = 2;
+      break;
+    case 2: // Run length
+      _run = c;
+      _sub = c ? 3 : 0;
+      break;
+    default: // Run values
+      if (_arg < 351)
+        buf[_arg] = c;
+      _arg++;
+      if (!--_run)
+        _sub = 0;
+      break;
+    }
+    break;
+  case IS3741_FRAME_PALETTE:
+    if (!_pos) {
+      _arg = c * 3; // First color's element index
+    } else if (_arg < sizeof _palette) {
+      _palette[_arg++] = c;
+    }
+    break;
+  case IS3741_FRAME_INDEXED: {
+    int16_t w = _display->width();
+    uint16_t p = _pos * 2; // First of two pixels in this byte
+    for (uint8_t i = 0; i < 2; i++, p++, c <<= 4) {
+      uint16_t idx[3];
+      if (_display->getLEDIndices(p % w, p / w, idx)) {
+        const uint8_t *rgb = &_palette[(c >> 4) * 3];
+        buf[idx[0]] = rgb[0];
+        buf[idx[1]] = rgb[1];
+        buf[idx[2]] = rgb[2];
+      }
+    }
+  } break;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Count a message as good or bad, and reply to sender if enabled.
+    @param  good  true if message was received intact.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_FrameReceiver::reply(bool good) {
+  if (good)
+    _frames++;
+  else
+    _errors++;
+  if (_ack)
+    _in->write(good ? IS3741_FRAME_ACK : IS3741_FRAME_NAK);
+}
+
+// BYTECODE PROGRAMS -------------------------------------------------------
+// run() checks each instruction against this table before executing it,
+// so the cases in its switch can use stack slots without further checks.
+// Bits 0-1 are operand bytes following the opcode, 2-4 values popped and
+// 5-6 values pushed (a value both read and replaced counts as both).
+
+#define _IS31_VM_OP_(_OPERANDS_, _POPS_, _PUSHES_)                             \
+  ((_OPERANDS_) | ((_POPS_) << 2) | ((_PUSHES_) << 5))
+
+// Stop program on error, leaving pc() at the offending instruction.
+#define _IS31_VM_FAIL_(_AT_)                                                   \
+  {                                                                            \
+    _pc = _AT_;                                                                \
+    return _status = IS3741_VM_ERROR;                                          \
+  }
+
+// Clip a program's span (x & w, or y & h) to 0 to size-1, in 32-bit math
+// before GFX narrows it to int16_t. GFX only clips pixel by pixel, so a
+// huge rectangle would otherwise take a billion drawPixel() calls inside
+// one instruction. Returns false if nothing's left to draw.
+static bool _IS31clipSpan(int32_t *pos, int32_t *len, int16_t size) {
+  int64_t end = (int64_t)*pos + *len;
+  if ((*len <= 0) || (*pos >= size) || (end <= 0))
+    return false;
+  if (*pos < 0)
+    *pos = 0;
+  *len = ((end > size) ? size : end) - *pos;
+  return true;
+}
+
+static const uint8_t PROGMEM _IS31vmInfo[IS3741_OP_COUNT] = {
+    _IS31_VM_OP_(0, 0, 0), // HALT
+    _IS31_VM_OP_(1, 0, 1), // PUSH8
+    _IS31_VM_OP_(2, 0, 1), // PUSH16
+    _IS31_VM_OP_(3, 0, 1), // PUSH24
+    _IS31_VM_OP_(0, 1, 2), // DUP
+    _IS31_VM_OP_(0, 1, 0), // DROP
+    _IS31_VM_OP_(0, 2, 2), // SWAP
+    _IS31_VM_OP_(0, 2, 3), // OVER
+    _IS31_VM_OP_(1, 0, 1), // LOAD
+    _IS31_VM_OP_(1, 1, 0), // STORE
+    _IS31_VM_OP_(0, 2, 1), // ADD
+    _IS31_VM_OP_(0, 2, 1), // SUB
+    _IS31_VM_OP_(0, 2, 1), // MUL
+    _IS31_VM_OP_(0, 2, 1), // DIV
+    _IS31_VM_OP_(0, 2, 1), // MOD
+    _IS31_VM_OP_(0, 2, 1), // AND
+    _IS31_VM_OP_(0, 2, 1), // OR
+    _IS31_VM_OP_(0, 2, 1), // XOR
+    _IS31_VM_OP_(0, 2, 1), // SHL
+    _IS31_VM_OP_(0, 2, 1), // SHR
+    _IS31_VM_OP_(0, 2, 1), // LT
+    _IS31_VM_OP_(0, 2, 1), // EQ
+    _IS31_VM_OP_(0, 1, 1), // NOT
+    _IS31_VM_OP_(0, 1, 0), // REPEAT
+    _IS31_VM_OP_(0, 0, 0), // NEXT
+    _IS31_VM_OP_(0, 0, 1), // INDEX
+    _IS31_VM_OP_(0, 1, 0), // IF
+    _IS31_VM_OP_(0, 0, 0), // ENDIF
+    _IS31_VM_OP_(0, 1, 1), // SIN
+    _IS31_VM_OP_(0, 0, 1), // RAND
+    _IS31_VM_OP_(0, 0, 1), // FRAME
+    _IS31_VM_OP_(0, 3, 1), // HSV
+    _IS31_VM_OP_(0, 3, 1), // RGB
+    _IS31_VM_OP_(0, 1, 0), // FILL
+    _IS31_VM_OP_(0, 3, 0), // PIXEL
+    _IS31_VM_OP_(0, 4, 0), // HLINE
+    _IS31_VM_OP_(0, 5, 0), // RECT
+    _IS31_VM_OP_(0, 3, 0), // RING
+    _IS31_VM_OP_(0, 2, 0), // RINGFILL
+    _IS31_VM_OP_(0, 1, 0), // DIM
+    _IS31_VM_OP_(0, 1, 0), // BLUR
+    _IS31_VM_OP_(0, 1, 0), // WAIT
+    _IS31_VM_OP_(0, 0, 0), // SHOW
+};
+
+/**************************************************************************/
+/*!
+    @brief  Constructor for bytecode interpreter. Nothing runs until a
+            program is passed to load().
+    @param  display  Pointer to buffered matrix object (e.g.
+                     Adafruit_IS31FL3741_QT_buffered or
+                     Adafruit_EyeLights_buffered) to draw into.
+*/
+/**************************************************************************/
+Adafruit_IS31FL3741_VM::Adafruit_IS31FL3741_VM(
+    Adafruit_IS31FL3741_colorGFX_buffered *display)
+    : _display(display) {}
+
+/**************************************************************************/
+/*!
+    @brief  Set EyeLights rings for RING and RINGFILL instructions, which
+            are ignored otherwise.
+    @param  left   Pointer to left ring object (e.g. &glasses.left_ring),
+                   or NULL.
+    @param  right  Pointer to right ring object, or NULL.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_VM::setRings(Adafruit_EyeLights_Ring_buffered *left,
+                                      Adafruit_EyeLights_Ring_buffered *right) {
+  _ring[0] = left;
+  _ring[1] = right;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Start a new program from the beginning, clearing variables.
+    @param  program  Pointer to bytecode, which must persist (e.g. global
+                     or PROGMEM) while the program runs.
+    @param  len      Program length in bytes.
+    @param  progmem  true if program is in PROGMEM, false if in RAM.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_VM::load(const uint8_t *program, uint16_t len,
+                                  bool progmem) {
+  _prog = program;
+  _len = len;
+  _progmem = progmem;
+  _pc = _sp = _lp = 0;
+  _count = 0;
+  _frame = 0;
+  _waiting = false;
+  memset(_var, 0, sizeof _var);
+  _status = len ? IS3741_VM_FRAME : IS3741_VM_HALT; // Anything but HALT/ERR
+}
+
+/**************************************************************************/
+/*!
+    @brief    Read a program from a Stream (e.g. Serial, or an SD card
+              File) into RAM and start it. Reading stops when buffer is
+              full or no more data arrives within the stream's timeout
+              (see Stream::setTimeout()).
+    @param    in    Stream to read from.
+    @param    buf   Buffer to hold program, which must persist while the
+                    program runs.
+    @param    size  Buffer size in bytes.
+    @returns  uint16_t  Program length read.
+*/
+/**************************************************************************/
+uint16_t Adafruit_IS31FL3741_VM::load(Stream *in, uint8_t *buf,
+                                      uint16_t size) {
+  uint16_t len = in->readBytes(buf, size);
+  load(buf, len);
+  return len;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Run program until it shows a frame, starts or is still in a
+              WAIT, or has executed a number of instructions, whichever
+              comes first. Call every pass through loop(); never blocks.
+    @param    budget  Maximum instructions to execute in this call, so a
+                      long (or runaway) program can't hog the processor.
+    @returns  IS3741_vmStatus  Why it returned: IS3741_VM_FRAME,
+                               IS3741_VM_WAIT, IS3741_VM_BUDGET,
+                               IS3741_VM_HALT or IS3741_VM_ERROR.
+*/
+/**************************************************************************/
+IS3741_vmStatus Adafruit_IS31FL3741_VM::run(uint16_t budget) {
+  if (_status >= IS3741_VM_HALT)
+    return _status;
+  if (_waiting) {
+    if ((int32_t)(millis() - _wake) < 0)
+      return IS3741_VM_WAIT;
+    _waiting = false;
+  }
+
+  while (budget--) {
+    if (_pc >= _len) // End of program, start over
+      _pc = _lp = 0;
+    uint16_t at = _pc;
+    uint8_t op = fetch();
+    if (op >= IS3741_OP_COUNT)
+      _IS31_VM_FAIL_(at);
+    uint8_t info = pgm_read_byte(&_IS31vmInfo[op]);
+    uint8_t pops = (info >> 2) & 7, pushes = info >> 5;
+    if ((_sp < pops) || ((_sp - pops + pushes) > IS3741_VM_STACK) ||
+        ((_pc + (info & 3)) > _len))
+      _IS31_VM_FAIL_(at);
+    int32_t *s = &_stack[_sp - pops]; // Inputs & outputs start here
+    _sp = _sp - pops + pushes;
+    _count++;
+
+    switch (op) {
+    case IS3741_OP_HALT:
+      _pc = at;
+      return _status = IS3741_VM_HALT;
+    case IS3741_OP_PUSH8:
+      s[0] = (int8_t)fetch();
+      break;
+    case IS3741_OP_PUSH16:
+      s[0] = fetch();
+      s[0] = (int16_t)(s[0] | (fetch() << 8));
+      break;
+    case IS3741_OP_PUSH24:
+      s[0] = fetch();
+      s[0] |= (uint16_t)fetch() << 8;
+      s[0] |= (uint32_t)fetch() << 16;
+      break;
+    case IS3741_OP_DUP:
+      s[1] = s[0];
+      break;
+    case IS3741_OP_DROP:
+      break;
+    case IS3741_OP_SWAP: {
+      int32_t t = s[0];
+      s[0] = s[1];
+      s[1] = t;
+    } break;
+    case IS3741_OP_OVER:
+      s[2] = s[0];
+      break;
+    case IS3741_OP_LOAD:
+      s[0] = _var[fetch() % IS3741_VM_VARS];
+      break;
+    case IS3741_OP_STORE:
+      _var[fetch() % IS3741_VM_VARS] = s[0];
+      break;
+    // Arithmetic is done unsigned so overflow wraps rather than being
+    // undefined, and -1 divisors are special-cased as INT32_MIN / -1
+    // (and % -1) traps on some processors.
+    case IS3741_OP_ADD:
+      s[0] = (uint32_t)s[0] + (uint32_t)s[1];
+      break;
+    case IS3741_OP_SUB:
+      s[0] = (uint32_t)s[0] - (uint32_t)s[1];
+      break;
+    case IS3741_OP_MUL:
+      s[0] = (uint32_t)s[0] * (uint32_t)s[1];
+      break;
+    case IS3741_OP_DIV:
+      if (s[1] == -1)
+        s[0] = 0 - (uint32_t)s[0];
+      else
+        s[0] = s[1] ? (s[0] / s[1]) : 0;
+      break;
+    case IS3741_OP_MOD:
+      s[0] = ((s[1] == -1) || !s[1]) ? 0 : (s[0] % s[1]);
+      break;
+    case IS3741_OP_AND:
+      s[0] &= s[1];
+      break;
+    case IS3741_OP_OR:
+      s[0] |= s[1];
+      break;
+    case IS3741_OP_XOR:
+      s[0] ^= s[1];
+      break;
+    case IS3741_OP_SHL:
+      s[0] = (uint32_t)s[0] << (s[1] & 31);
+      break;
+    case IS3741_OP_SHR:
+      s[0] >>= (s[1] & 31);
+      break;
+    case IS3741_OP_LT:
+      s[0] = s[0] < s[1];
+      break;
+    case IS3741_OP_EQ:
+      s[0] = s[0] == s[1];
+      break;
+    case IS3741_OP_NOT:
+      s[0] = !s[0];
+      break;
+    case IS3741_OP_REPEAT:
+      if (s[0] <= 0) { // Zero times, skip past NEXT
+        if (!skip(IS3741_OP_REPEAT, IS3741_OP_NEXT))
+          _IS31_VM_FAIL_(at);
+      } else {
+        if (_lp >= IS3741_VM_LOOPS)
+          _IS31_VM_FAIL_(at);
+        _loopPC[_lp] = _pc;
+        _loopIndex[_lp] = 0;
+        _loopCount[_lp++] = (s[0] > 65535) ? 65535 : s[0];
+      }
+      break;
+    case IS3741_OP_NEXT:
+      if (!_lp)
+        _IS31_VM_FAIL_(at);
+      if (++_loopIndex[_lp - 1] < _loopCount[_lp - 1])
+        _pc = _loopPC[_lp - 1];
+      else
+        _lp--;
+      break;
+    case IS3741_OP_INDEX:
+      s[0] = _lp ? _loopIndex[_lp - 1] : 0;
+      break;
+    case IS3741_OP_IF:
+      if (!s[0] && !skip(IS3741_OP_IF, IS3741_OP_ENDIF))
+        _IS31_VM_FAIL_(at);
+      break;
+    case IS3741_OP_ENDIF:
+      break;
+    case IS3741_OP_SIN:
+      s[0] = _display->sin16(s[0]);
+      break;
+    case IS3741_OP_RAND:
+      _seed ^= _seed << 13; // Xorshift32
+      _seed ^= _seed >> 17;
+      _seed ^= _seed << 5;
+      s[0] = _seed >> 16;
+      break;
+    case IS3741_OP_FRAME:
+      s[0] = _frame;
+      break;
+    case IS3741_OP_HSV:
+      s[0] = _display->ColorHSV(s[0], s[1], s[2]);
+      break;
+    case IS3741_OP_RGB:
+      s[0] = _display->Color(s[0], s[1], s[2]);
+      break;
+    case IS3741_OP_FILL:
+      _display->fill(_display->color565((uint32_t)s[0]));
+      break;
+    case IS3741_OP_PIXEL: {
+      int32_t w = 1, h = 1;
+      if (_IS31clipSpan(&s[0], &w, _display->width()) &&
+          _IS31clipSpan(&s[1], &h, _display->height()))
+        _display->drawPixel(s[0], s[1], _display->color565((uint32_t)s[2]));
+    } break;
+    case IS3741_OP_HLINE: {
+      int32_t h = 1;
+      if (_IS31clipSpan(&s[0], &s[2], _display->width()) &&
+          _IS31clipSpan(&s[1], &h, _display->height()))
+        _display->drawFastHLine(s[0], s[1], s[2],
+                                _display->color565((uint32_t)s[3]));
+    } break;
+    case IS3741_OP_RECT:
+      if (_IS31clipSpan(&s[0], &s[2], _display->width()) &&
+          _IS31clipSpan(&s[1], &s[3], _display->height()))
+        _display->fillRect(s[0], s[1], s[2], s[3],
+                           _display->color565((uint32_t)s[4]));
+      break;
+    case IS3741_OP_RING:
+      if (_ring[s[0] & 1])
+        _ring[s[0] & 1]->setPixelColor(s[1], (uint32_t)s[2]);
+      break;
+    case IS3741_OP_RINGFILL:
+      if (_ring[s[0] & 1])
+        _ring[s[0] & 1]->fill((uint32_t)s[1]);
+      break;
+    case IS3741_OP_DIM:
+      _display->dim(s[0]);
+      break;
+    case IS3741_OP_BLUR:
+      _display->blur(s[0]);
+      break;
+    case IS3741_OP_WAIT:
+      _wake = millis() + s[0];
+      _waiting = true;
+      return IS3741_VM_WAIT;
+    case IS3741_OP_SHOW:
+      _display->show();
+      _frame++;
+      return IS3741_VM_FRAME;
+    }
+  }
+  return IS3741_VM_BUDGET;
+}
+
+/**************************************************************************/
+/*!
+    @brief    Fetch next program byte and advance program counter.
+    @returns  uint8_t  Program byte.
+*/
+/**************************************************************************/
+uint8_t Adafruit_IS31FL3741_VM::fetch(void) {
+  return _progmem ? pgm_read_byte(&_prog[_pc++]) : _prog[_pc++];
+}
+
+/**************************************************************************/
+/*!
+    @brief    Advance program counter past the instruction closing a block
+              (NEXT or ENDIF), allowing for nested blocks.
+    @param    open   Opcode that opens a block (REPEAT or IF).
+    @param    close  Opcode that closes it (NEXT or ENDIF).
+    @returns  bool  true on success, false if the end of the program or
+                    an invalid opcode came first.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741_VM::skip(uint8_t open, uint8_t close) {
+  uint8_t depth = 1;
+  while (_pc < _len) {
+    uint8_t op = fetch();
+    if (op >= IS3741_OP_COUNT)
+      return false;
+    _pc += pgm_read_byte(&_IS31vmInfo[op]) & 3; // Skip operands
+    if (op == open) {
+      depth++;
+    } else if ((op == close) && !--depth) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// MIRRORED DISPLAYS -------------------------------------------------------
+
+/**************************************************************************/
+/*!
+    @brief  Constructor for mirror group.
+    @param  source  Pointer to buffered object that all drawing goes to
+                    (e.g. Adafruit_IS31FL3741_QT_buffered). It's shown
+                    too; add() the other boards that should match it.
+*/
+/**************************************************************************/
+Adafruit_IS31FL3741_Mirror::Adafruit_IS31FL3741_Mirror(
+    Adafruit_IS31FL3741_colorGFX_buffered *source)
+    : _source(source) {}
+
+/**************************************************************************/
+/*!
+    @brief    Add a member display, wired in the same color order as the
+              source board.
+    @param    member    Pointer to unbuffered object for another board of
+                        the same type, begin() already called.
+    @param    rotation  How the member is mounted relative to the source,
+                        in GFX-style quarter turns (0-3). 1 and 3 are only
+                        allowed if the matrix is square.
+    @returns  bool  true on success, false if group is full or rotation
+                    doesn't fit the matrix.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741_Mirror::add(Adafruit_IS31FL3741 *member,
+                                     uint8_t rotation) {
+  return add(member, rotation,
+             (IS3741_order)((_source->rOffset << 4) |
+                            (_source->gOffset << 2) | _source->bOffset));
+}
+
+/**************************************************************************/
+/*!
+    @brief    Add a member display that's wired in a different color order
+              from the source board.
+    @param    member    Pointer to unbuffered object for another board of
+                        the same type, begin() already called.
+    @param    rotation  How the member is mounted relative to the source,
+                        in GFX-style quarter turns (0-3). 1 and 3 are only
+                        allowed if the matrix is square.
+    @param    order     One of the IS3741_* color types (e.g. IS3741_RGB),
+                        the member's own color order.
+    @returns  bool  true on success, false if group is full or rotation
+                    doesn't fit the matrix.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741_Mirror::add(Adafruit_IS31FL3741 *member,
+                                     uint8_t rotation, IS3741_order order) {
+  rotation &= 3;
+  if (!member || (_count >= IS3741_MIRROR_MAX) ||
+      ((rotation & 1) && (_source->WIDTH != _source->HEIGHT)))
+    return false;
+  IS3741_mirrorMember *m = &_member[_count++];
+  m->display = member;
+  m->rotation = rotation;
+  // mapPixel() returns slots in the source's color order. For each of the
+  // member's R,G,B, find which of those slots holds the element position
+  // the member expects that color in.
+  const uint8_t want[] = {(uint8_t)((order >> 4) & 3),
+                          (uint8_t)((order >> 2) & 3), (uint8_t)(order & 3)};
+  const uint8_t have[] = {_source->rOffset, _source->gOffset,
+                          _source->bOffset};
+  m->direct = !rotation;
+  for (uint8_t c = 0; c < 3; c++) {
+    for (uint8_t k = 0; k < 3; k++) {
+      if (have[k] == want[c])
+        m->element[c] = k;
+    }
+    if (m->element[c] != c)
+      m->direct = false;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Send the source object's buffer to its own board and then to
+            each member, rotating and reordering colors as needed.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_Mirror::show(void) {
+  _source->show();
+  for (uint8_t i = 0; i < _count; i++) {
+    if (_member[i].direct) {
+      _member[i].display->writeBuffer(_source->getBuffer() - 1);
+    } else {
+      stream(&_member[i]);
+    }
+  }
+}
+
+// stream() source and member, passed through writeTwoPages() to
+// streamChunk().
+typedef struct {
+  Adafruit_IS31FL3741_colorGFX_buffered *source; // Object being drawn to
+  const IS3741_mirrorMember *member;             // Display to copy to
+} _IS31mirrorStream;
+
+/**************************************************************************/
+/*!
+    @brief  Send the source buffer to one rotated or reordered member. Each
+            I2C write is assembled by walking all pixels and picking out
+            those whose elements land in that write's register range, so
+            no full-size buffer is needed. Elements not belonging to any
+            pixel (EyeLights rings, unused registers) are copied as-is.
+    @param  m  Pointer to member.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_Mirror::stream(const IS3741_mirrorMember *m) {
+  uint8_t chunk[IS3741_MIRROR_CHUNK + 1]; // +1 for register address
+  uint8_t max = m->display->_i2c_dev->maxBufferSize() - 1;
+  if (max > IS3741_MIRROR_CHUNK)
+    max = IS3741_MIRROR_CHUNK;
+  _IS31mirrorStream s = {_source, m};
+  m->display->writeTwoPages(0, chunk, max, streamChunk, &s);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fill one chunk of a member's PWM registers for stream().
+    @param  data   Chunk of PWM values to fill.
+    @param  start  LED index of data[0].
+    @param  len    Number of values in chunk.
+    @param  arg    Pointer to _IS31mirrorStream source and member.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_Mirror::streamChunk(uint8_t *data, uint16_t start,
+                                             uint8_t len, void *arg) {
+  const _IS31mirrorStream *s = (const _IS31mirrorStream *)arg;
+  Adafruit_IS31FL3741_colorGFX_buffered *source = s->source;
+  const IS3741_mirrorMember *m = s->member;
+  const uint8_t *buf = source->getBuffer();
+  const int16_t w = source->WIDTH, h = source->HEIGHT;
+  memcpy(data, &buf[start], len);
+  for (int16_t y = 0; y < h; y++) {
+    for (int16_t x = 0; x < w; x++) {
+      uint16_t dst[3], src[3];
+      if (!source->mapPixel(x, y, dst))
+        continue;
+      // Unsigned math, so anything before start is also out of range
+      if (((uint16_t)(dst[0] - start) >= len) &&
+          ((uint16_t)(dst[1] - start) >= len) &&
+          ((uint16_t)(dst[2] - start) >= len))
+        continue;
+      int16_t sx = x, sy = y; // Source pixel shown at member's (x,y)
+      switch (m->rotation) {
+      case 1:
+        sx = w - 1 - y;
+        sy = x;
+        break;
+      case 2:
+        sx = w - 1 - x;
+        sy = h - 1 - y;
+        break;
+      case 3:
+        sx = y;
+        sy = h - 1 - x;
+        break;
+      }
+      bool lit = source->mapPixel(sx, sy, src); // false if a hole
+      for (uint8_t c = 0; c < 3; c++) {
+        uint16_t i = dst[m->element[c]] - start;
+        if (i < len)
+          data[i] = lit ? buf[src[c]] : 0;
+      }
+    }
+  }
+}
+
+// HARDWARE BLINK ----------------------------------------------------------
+
+/**************************************************************************/
+/*!
+    @brief  Constructor for blinker.
+    @param  display  Pointer to any IS31FL3741 object (direct or buffered)
+                     whose whole display is to blink.
+*/
+/**************************************************************************/
+Adafruit_IS31FL3741_Blink::Adafruit_IS31FL3741_Blink(
+    Adafruit_IS31FL3741 *display)
+    : _display(display) {}
+
+/**************************************************************************/
+/*!
+    @brief  Start blinking (or strobing, with a short duty cycle). Display
+            starts in the lit part of the cycle.
+    @param  period  Length of one on+off cycle in milliseconds, 2 or more.
+    @param  duty    Portion of period spent lit, 0-255, where 128 is half
+                    and 255 is the whole period (except 1/256th). Default
+                    is 128.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_Blink::start(uint16_t period, uint8_t duty) {
+  if (period < 2)
+    period = 2;
+  _period = period;
+  _onTime = ((uint32_t)period * (duty + 1)) >> 8;
+  if (!_onTime)
+    _onTime = 1;
+  _start = millis();
+  _lit = true;
+  _display->enable(true);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Stop blinking and leave the display lit.
+*/
+/**************************************************************************/
+void Adafruit_IS31FL3741_Blink::stop(void) {
+  _period = 0;
+  _lit = true;
+  _display->enable(true);
+}
+
+/**************************************************************************/
+/*!
+    @brief    Turn display on or off if the time has come. Call often,
+              e.g. every pass through loop(); edges are only as accurate
+              as the calls are frequent. Each edge is one configuration
+              register write (shutdown bit), LED data is untouched. Not
+              for use in interrupt handlers (it does I2C).
+    @returns  bool  true if display was switched on or off.
+*/
+/**************************************************************************/
+bool Adafruit_IS31FL3741_Blink::poll(void) {
+  if (!_period)
+    return false;
+  bool lit = ((millis() - _start) % _period) < _onTime;
+  if (lit == _lit)
+    return false;
+  _lit = lit;
+  _display->enable(lit);
+  return true;
+}
@@ -16,6 +16,7 @@
 
 #define IS3741_FUNCREG_CONFIG 0x00
 #define IS3741_FUNCREG_GCURRENT 0x01
+#define IS3741_FUNCREG_PWMFREQ 0x36
 #define IS3741_FUNCREG_RESET 0x3F
 
 // RGB pixel color order permutations
@@ -29,6 +30,49 @@ typedef enum {
   IS3741_BGR = ((2 << 4) | (1 << 2) | (0)), // Encode as B,G,R
 } IS3741_order;
 
+// PWM frequencies for setPWMFrequency(). 29 kHz is both the chip's fastest
+// and its power-on default, so IS3741_PWM_CAMERA changes nothing unless a
+// lower frequency was set earlier; if video still shows banding at 29 kHz,
+// the fix is on the camera side (shutter speed), the chip can't go faster.
+typedef enum {
+  IS3741_PWM_29KHZ = 0x00,  ///< 29 kHz (power-on default)
+  IS3741_PWM_3600HZ = 0x03, ///< 3.6 kHz
+  IS3741_PWM_1800HZ = 0x07, ///< 1.8 kHz
+  IS3741_PWM_900HZ = 0x0B,  ///< 900 Hz
+} IS3741_pwmFreq;
+
+#define IS3741_PWM_CAMERA IS3741_PWM_29KHZ   ///< Fastest = least banding
+#define IS3741_PWM_LOWPOWER IS3741_PWM_900HZ ///< Fewest switching edges
+
+// Callback for writeTwoPages(): fill data[0] to data[len-1] with register
+// values for LEDs start to start+len-1. arg is passed through from caller.
+typedef void (*IS3741_chunkFunc)(uint8_t *data, uint16_t start, uint8_t len,
+                                 void *arg);
+
+// White balance presets for setWhiteBalance(), as 0xRRGGBB gains
+#define IS3741_WHITE_NONE 0xFFFFFF    ///< No correction
+#define IS3741_WHITE_NEUTRAL 0xFFB4C8 ///< Typical RGB LEDs to neutral white
+#define IS3741_WHITE_WARM 0xFF8C50    ///< Incandescent-like warm white
+#define IS3741_WHITE_COOL 0xC8C8FF    ///< Bluish cool white
+
+// Convert a constant (e.g. 1.5) to 16.16 fixed-point at compile time, for
+// use with the IS3741_affine transform and setRotoZoom().
+#define IS3741_FIXED(x) ((int32_t)((x) * 65536.0))
+
+// 2x3 affine transform for drawAffine(), all elements 16.16 fixed-point.
+// Maps destination point (x,y) to source bitmap point (u,v):
+//   u = a * x + b * y + tx
+//   v = c * x + d * y + ty
+// Pixel edges are at integer coordinates (centers at +0.5) in both spaces.
+typedef struct {
+  int32_t a;  ///< X step in source per destination column
+  int32_t b;  ///< X step in source per destination row
+  int32_t c;  ///< Y step in source per destination column
+  int32_t d;  ///< Y step in source per destination row
+  int32_t tx; ///< Source X at destination origin
+  int32_t ty; ///< Source Y at destination origin
+} IS3741_affine;
+
 // 8-bit gamma correction table for the gamma8() and gamma32() funcs.
 static const uint8_t PROGMEM _IS31GammaTable[256] = {
     0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
@@ -52,6 +96,8 @@ static const uint8_t PROGMEM _IS31GammaTable[256] = {
 
 // BASE IS31 CLASSES -------------------------------------------------------
 
+class Adafruit_IS31FL3741_TraceSink; // See TRANSACTION TRACING below
+
 /**************************************************************************/
 /*!
     @brief  Class for Lumissil IS31FL3741 LED driver. This is the base class
@@ -76,11 +122,20 @@ public:
   bool setGlobalCurrent(uint8_t current);
   uint8_t getGlobalCurrent(void);
 
+  bool setScanLines(uint8_t lines);
+  uint8_t getScanLines(void);
+  bool setPWMFrequency(IS3741_pwmFreq freq);
+  IS3741_pwmFreq getPWMFrequency(void);
+
   bool setLEDscaling(uint16_t lednum, uint8_t scale);
   bool setLEDscaling(uint8_t scale);
+  bool writeScaling(const uint8_t *scales, bool progmem = false);
 
   bool setLEDPWM(uint16_t lednum, uint8_t pwm);
   bool fill(uint8_t fillpwm = 0);
+  void writeBuffer(uint8_t *buf);
+  bool writeRaw(const uint8_t *buf, uint16_t len);
+  void setTrace(Adafruit_IS31FL3741_TraceSink *sink);
 
   /*!
     @brief  Empty function makes direct & buffered code more interchangeable.
@@ -160,14 +215,34 @@ public:
   // These are documented in .cpp file:
   static uint32_t gamma32(uint32_t x);
   static uint32_t ColorHSV(uint16_t hue, uint8_t sat = 255, uint8_t val = 255);
+  static int16_t sin16(uint16_t angle);
+  /*!
+    @brief   Fixed-point cosine, see sin16() for details.
+    @param   angle  0 to 65535 for one full turn.
+    @return  Cosine of angle, -32767 to +32767.
+  */
+  static int16_t cos16(uint16_t angle) { return sin16(angle + 16384); }
 
 protected:
   bool selectPage(uint8_t page);
   bool setLEDvalue(uint8_t first_page, uint16_t lednum, uint8_t value);
   bool fillTwoPages(uint8_t first_page, uint8_t value);
+  bool writeTwoPages(uint8_t first_page, uint8_t *buf, uint8_t max,
+                     IS3741_chunkFunc func, void *arg);
+  bool i2cWrite(const uint8_t *buf, uint16_t len);
+  bool writeRegister(uint8_t reg, uint8_t value);
+  bool readRegisters(uint8_t reg, uint8_t *buf, uint8_t len);
+  bool writeConfig(uint8_t keep, uint8_t set);
 
   int8_t _page = -1; ///< Cached value of the page we're currently addressing
   Adafruit_I2CDevice *_i2c_dev = NULL; ///< Pointer to I2C device
+
+  int16_t _config = -1; ///< Cached config register, -1 if unknown
+  int8_t _pwmFreq = -1; ///< Cached PWM frequency register, -1 if unknown
+
+  Adafruit_IS31FL3741_TraceSink *_trace = NULL; ///< Transaction recorder
+
+  friend class Adafruit_IS31FL3741_Mirror; // Streams to members' pages
 };
 
 /**************************************************************************/
@@ -190,8 +265,28 @@ public:
     @returns  uint8_t*  Pointer to first LED position in buffer.
   */
   uint8_t *getBuffer(void) { return &ledbuf[1]; } // See notes in show()
+  void setISRSafe(bool on);
+  void setLEDsFromISR(const uint16_t *idx, const uint8_t *value, uint8_t n);
+  /*!
+    @brief  Set one LED buffer element from an interrupt handler.
+            See setLEDsFromISR().
+    @param  lednum  Index into getBuffer(), 0-350.
+    @param  value   PWM value, 0-255.
+  */
+  void setLEDFromISR(uint16_t lednum, uint8_t value) {
+    setLEDsFromISR(&lednum, &value, 1);
+  }
+  void dim(uint8_t level);
+  void blend(const uint8_t *frame, uint8_t amount);
+  void applyGamma(void);
+  void writeBlocks(uint32_t mask);
+
 protected:
   uint8_t ledbuf[352]; ///< LEDs in RAM. +1 byte is intentional, see show()
+
+  volatile uint32_t _dirty = 0; ///< Blocks changed by ISR since last copy
+  volatile uint8_t _isrSeq = 0; ///< Bumped around each ISR write (seqlock)
+  bool _isrSafe = false;        ///< If set, show() uses writeBlocks()
 };
 
 // INTERMEDIARY CLASSES FOR COLORS AND GFX ---------------------------------
@@ -271,6 +366,44 @@ public:
                                         IS3741_order order);
   // Overload the base (monochrome) fill() with a GFX RGB565-style color.
   void fill(uint16_t color = 0);
+  void drawAffine(const uint16_t *bitmap, int16_t w, int16_t h,
+                  const IS3741_affine *xform, bool smooth = false);
+  void drawFrame(const uint16_t *frame, bool gamma = false);
+  static void setRotoZoom(IS3741_affine *xform, uint16_t angle, int32_t zoom,
+                          int32_t srcX, int32_t srcY, int32_t dstX,
+                          int32_t dstY);
+  bool getLEDIndices(int16_t x, int16_t y, uint16_t *idx);
+  void drawPixelFromISR(int16_t x, int16_t y, uint16_t color);
+  void blur(uint8_t amount = 255);
+  void bloom(uint8_t threshold = 128, uint8_t strength = 128);
+  virtual bool setWhiteBalance(uint32_t balance, const uint8_t *scales = NULL,
+                               bool progmem = false);
+
+protected:
+  /*!
+    @brief    Map an unrotated pixel position to buffer indices. Each
+              buffered subclass in this library provides its own, as it
+              does drawPixel(). Subclasses that don't (e.g. older user
+              code) get this default, which reports no LED anywhere, so
+              functions relying on it simply skip every pixel.
+    @param    x    Native (unrotated) column, already clipped.
+    @param    y    Native (unrotated) row, already clipped.
+    @param    idx  Array of 3 uint16_t to receive R,G,B buffer indices.
+    @returns  bool  true if a physical LED exists at this position.
+  */
+  virtual bool mapPixel(int16_t x, int16_t y, uint16_t *idx) {
+    (void)x;
+    (void)y;
+    (void)idx;
+    return false;
+  }
+  void blurLine(int16_t x, int16_t y, int16_t dx, int16_t dy, int16_t n,
+                uint16_t amount);
+  void brightPass(int16_t x, int16_t y, uint8_t threshold, uint8_t *rgb);
+  static void balanceChunk(uint8_t *data, uint16_t start, uint8_t len,
+                           void *arg);
+
+  friend class Adafruit_IS31FL3741_Mirror; // Uses mapPixel() for members
 };
 
 /* =======================================================================
@@ -325,6 +458,9 @@ public:
   Adafruit_IS31FL3741_EVB_buffered(IS3741_order order = IS3741_BGR)
       : Adafruit_IS31FL3741_colorGFX_buffered(9, 13, order) {}
   void drawPixel(int16_t x, int16_t y, uint16_t color);
+
+protected:
+  bool mapPixel(int16_t x, int16_t y, uint16_t *idx);
 };
 
 /**************************************************************************/
@@ -362,6 +498,9 @@ public:
   Adafruit_IS31FL3741_QT_buffered(IS3741_order order = IS3741_BGR)
       : Adafruit_IS31FL3741_colorGFX_buffered(13, 9, order) {}
   void drawPixel(int16_t x, int16_t y, uint16_t color);
+
+protected:
+  bool mapPixel(int16_t x, int16_t y, uint16_t *idx);
 };
 
 /* =======================================================================
@@ -440,6 +579,8 @@ public:
       : Adafruit_EyeLights_Ring_Base(parent, isRight) {}
   void setPixelColor(int16_t n, uint32_t color);
   void setPixelColor(int16_t n, uint8_t r, uint8_t g, uint8_t b);
+  void addPixelColor(int16_t n, uint32_t color);
+  void setPixelColorFromISR(int16_t n, uint32_t color);
   void fill(uint32_t color);
   void fill(uint8_t r, uint8_t g, uint8_t b);
 };
@@ -495,7 +636,7 @@ public:
         Adafruit_IS31FL3741_colorGFX(18, 5, order), left_ring(this, false),
         right_ring(this, true) {}
   void drawPixel(int16_t x, int16_t y, uint16_t color);
-  void scale();
+  void scale(bool smooth = true);
   Adafruit_EyeLights_Ring left_ring;  ///< Left LED ring object
   Adafruit_EyeLights_Ring right_ring; ///< Right LED ring object
 };
@@ -524,9 +665,17 @@ public:
         Adafruit_IS31FL3741_colorGFX_buffered(18, 5, order),
         left_ring(this, false), right_ring(this, true) {}
   void drawPixel(int16_t x, int16_t y, uint16_t color);
-  void scale();
+  void scale(bool smooth = true);
+  void fill(uint16_t color = 0);
+  bool setWhiteBalance(uint32_t balance, const uint8_t *scales = NULL,
+                       bool progmem = false);
   Adafruit_EyeLights_Ring_buffered left_ring;  ///< Left LED ring object
   Adafruit_EyeLights_Ring_buffered right_ring; ///< Right LED ring object
+
+protected:
+  bool mapPixel(int16_t x, int16_t y, uint16_t *idx);
+  static void ringBalanceChunk(uint8_t *data, uint16_t start, uint8_t len,
+                               void *arg);
 };
 
 /* =======================================================================
@@ -731,4 +880,1045 @@ public:
       : Adafruit_IS31FL3741_GlassesRing_buffered(controller, true) {}
 };
 
+// PROCEDURAL EFFECTS ------------------------------------------------------
+
+/**************************************************************************/
+/*!
+    @brief  Class providing a few classic LED animations (plasma, noise,
+            fire, twinkle) for any of the buffered color matrices. Effects
+            write straight into the matrix's LED buffer (using its own
+            mapping, rotation and color order) with fixed-point math only,
+            and each call does a fixed amount of work per pixel, so frame
+            time depends only on matrix size, never on content. Call one
+            effect function per frame, followed by the matrix's show().
+*/
+/**************************************************************************/
+class Adafruit_IS31FL3741_Effects {
+public:
+  /*!
+    @brief  Constructor for Adafruit_IS31FL3741_Effects object.
+    @param  display  Pointer to buffered matrix object (e.g.
+                     Adafruit_IS31FL3741_QT_buffered or
+                     Adafruit_EyeLights_buffered) to draw into.
+  */
+  Adafruit_IS31FL3741_Effects(Adafruit_IS31FL3741_colorGFX_buffered *display)
+      : _display(display) {}
+  void plasma(uint8_t speed = 3, uint8_t scale = 24);
+  void noise(uint8_t speed = 3, uint8_t scale = 64, uint16_t hue = 0);
+  void fire(uint8_t cooling = 55, uint8_t sparking = 120);
+  void twinkle(uint32_t color = 0xFFFFFF, uint8_t density = 8,
+               uint8_t fade = 12);
+  /*!
+    @brief  Seed the pseudorandom generator used by fire() and twinkle(),
+            for repeatable (or differing) sequences.
+    @param  seed  Any nonzero 32-bit value.
+  */
+  void setSeed(uint32_t seed) { _seed = seed ? seed : 1; }
+  static int16_t noise16(uint16_t x, uint16_t y, uint16_t z);
+  static uint32_t heatColor(uint8_t heat);
+
+protected:
+  uint8_t random8(void);
+  void setLED(int16_t x, int16_t y, uint32_t color);
+  Adafruit_IS31FL3741_colorGFX_buffered *_display; ///< Matrix to draw into
+
+  uint32_t _seed = 0x2545F491;  ///< Xorshift PRNG state, never 0
+  uint16_t _time = 0;           ///< Animation time, advanced by speed
+  uint8_t _state[13 * 9] = {0}; ///< Per-pixel heat or twinkle level
+};
+
+/**************************************************************************/
+/*!
+    @brief  Particle system for sparkles, comets, confetti and such on any
+            buffered color matrix or EyeLights ring. Particles are stored
+            as separate arrays per field (not an array of structs) in a
+            fixed-size pool, nothing is allocated. Positions & velocities
+            are 8.8 fixed-point pixels (256 = one pixel), and particles are
+            added (not overwritten) into the LED buffer, clipping at full
+            brightness, so overlaps glow brighter over whatever was drawn
+            before. Not used directly, declare an
+            Adafruit_IS31FL3741_ParticlePool with the desired capacity.
+*/
+/**************************************************************************/
+class Adafruit_IS31FL3741_Particles {
+public:
+  Adafruit_IS31FL3741_Particles(
+      Adafruit_IS31FL3741_colorGFX_buffered *display, uint16_t capacity,
+      int16_t *x, int16_t *y, int16_t *vx, int16_t *vy, uint16_t *phase,
+      uint16_t *rate, uint16_t *hue);
+  int16_t spawn(int16_t x, int16_t y, int16_t vx, int16_t vy, uint8_t life,
+                uint16_t hue = 0);
+  void update(bool cull = true);
+  void render(void);
+  void render(Adafruit_EyeLights_Ring_buffered *ring);
+  void setColorRamp(const uint32_t *colors, uint8_t n);
+  /*!
+    @brief  Set acceleration applied to all particles each update().
+    @param  gx  Horizontal acceleration, 8.8 fixed-point pixels/frame^2.
+    @param  gy  Vertical acceleration, 8.8 fixed-point pixels/frame^2
+                (positive = down).
+  */
+  void setGravity(int16_t gx, int16_t gy) {
+    _gx = gx;
+    _gy = gy;
+  }
+  /*!
+    @brief  Set air resistance applied to all particles each update().
+    @param  drag  0 = none, 255 = stop almost immediately. Each frame,
+                  velocity is multiplied by (256 - drag) / 256.
+  */
+  void setDrag(uint8_t drag) { _drag = 256 - drag; }
+  /*!
+    @brief    Number of live particles.
+    @returns  uint16_t  Particle count, 0 to capacity.
+  */
+  uint16_t count(void) const { return _count; }
+  /*!
+    @brief  Remove all particles.
+  */
+  void clear(void) { _count = 0; }
+
+protected:
+  uint32_t color(uint16_t i) const;
+  void kill(uint16_t i);
+  Adafruit_IS31FL3741_colorGFX_buffered *_display; ///< Matrix to draw into
+
+  int16_t *_x;          ///< X positions, 8.8 fixed-point
+  int16_t *_y;          ///< Y positions, 8.8 fixed-point
+  int16_t *_vx;         ///< X velocities, 8.8 fixed-point per frame
+  int16_t *_vy;         ///< Y velocities, 8.8 fixed-point per frame
+  uint16_t *_phase;     ///< Age, 0 (born) to 65535 (dead)
+  uint16_t *_rate;      ///< Amount added to phase each frame
+  uint16_t *_hue;       ///< Hue (if no color ramp), as in ColorHSV()
+  uint32_t _ramp[4];    ///< Age color ramp, RGB888
+  uint8_t _rampStops;   ///< Number of colors in ramp, 0 = use hue
+  uint16_t _capacity;   ///< Maximum number of particles
+  uint16_t _count = 0;  ///< Number of live particles
+  int16_t _gx = 0;      ///< X acceleration, 8.8 fixed-point
+  int16_t _gy = 0;      ///< Y acceleration, 8.8 fixed-point
+  uint16_t _drag = 256; ///< Velocity multiplier, 256 = no drag
+};
+
+/**************************************************************************/
+/*!
+    @brief  Particle pool of a fixed capacity, storage is declared right
+            here (in the object, no allocation). Each particle uses 14
+            bytes of RAM, so size N to suit the microcontroller.
+    @tparam N  Maximum number of particles alive at once.
+*/
+/**************************************************************************/
+template <uint16_t N>
+class Adafruit_IS31FL3741_ParticlePool : public Adafruit_IS31FL3741_Particles {
+public:
+  /*!
+    @brief  Constructor for Adafruit_IS31FL3741_ParticlePool object.
+    @param  display  Pointer to buffered matrix object (e.g.
+                     Adafruit_IS31FL3741_QT_buffered or
+                     Adafruit_EyeLights_buffered) to draw into.
+  */
+  Adafruit_IS31FL3741_ParticlePool(
+      Adafruit_IS31FL3741_colorGFX_buffered *display)
+      : Adafruit_IS31FL3741_Particles(display, N, x, y, vx, vy, phase, rate,
+                                      hue) {}
+
+private:
+  int16_t x[N];      ///< X positions
+  int16_t y[N];      ///< Y positions
+  int16_t vx[N];     ///< X velocities
+  int16_t vy[N];     ///< Y velocities
+  uint16_t phase[N]; ///< Ages
+  uint16_t rate[N];  ///< Aging rates
+  uint16_t hue[N];   ///< Hues
+};
+
+// AUDIO SPECTRUM ----------------------------------------------------------
+
+#define IS3741_SPECTRUM_SAMPLES 128 ///< PCM samples per Spectrum::process()
+
+/**************************************************************************/
+/*!
+    @brief  Class for music-reactive spectrum displays. Takes blocks of
+            audio samples (from a microphone, file, or whatever), runs a
+            fixed-point FFT, groups frequencies logarithmically into one
+            band per matrix column and one per ring pixel, and draws bars
+            with falling peaks straight into a buffered matrix's LED
+            buffer. Integer math only. Uses about 600 bytes RAM, so it's
+            best suited to 32-bit microcontrollers.
+*/
+/**************************************************************************/
+class Adafruit_IS31FL3741_Spectrum {
+public:
+  /*!
+    @brief  Constructor for Adafruit_IS31FL3741_Spectrum object.
+    @param  display  Pointer to buffered matrix object (e.g.
+                     Adafruit_IS31FL3741_QT_buffered or
+                     Adafruit_EyeLights_buffered) to draw into.
+  */
+  Adafruit_IS31FL3741_Spectrum(Adafruit_IS31FL3741_colorGFX_buffered *display)
+      : _display(display) {}
+  void process(const int16_t *samples);
+  void render(void);
+  void render(Adafruit_EyeLights_Ring_buffered *ring);
+  /*!
+    @brief  Set loudness range mapped to bar heights. Units are 1/16 of a
+            doubling in FFT magnitude (about 0.375 dB), a full-scale sine
+            wave reads about 208.
+    @param  floor    Level shown as an empty bar (default 80), 0-254.
+    @param  ceiling  Level shown as a full bar (default 208), above floor.
+  */
+  void setRange(uint8_t floor, uint8_t ceiling) {
+    if (floor > 254)
+      floor = 254; // Leave room for a ceiling above it
+    _floor = floor;
+    _ceiling = (ceiling > floor) ? ceiling : floor + 1;
+  }
+  /*!
+    @brief  Set how quickly bars and peak markers fall after a sound.
+    @param  bar   Bar drop per process() call, 1-255 of full height.
+    @param  peak  Peak marker drop per process() call, usually smaller.
+  */
+  void setDecay(uint8_t bar, uint8_t peak) {
+    _barDecay = bar;
+    _peakDecay = peak;
+  }
+  /*!
+    @brief    Current level of one matrix column band.
+    @param    band  Band index, 0 (lowest frequencies) and up.
+    @returns  uint8_t  Level, 0-255.
+  */
+  uint8_t getLevel(uint8_t band) const {
+    return (band < 24) ? _level[band] : 0;
+  }
+  static void fft(int16_t *re, int16_t *im, uint8_t log2n);
+
+protected:
+  void bands(uint8_t n, uint8_t *levels, uint8_t *peaks);
+  Adafruit_IS31FL3741_colorGFX_buffered *_display; ///< Matrix to draw into
+
+  int16_t _re[IS3741_SPECTRUM_SAMPLES]; ///< FFT real parts, then magnitudes
+  int16_t _im[IS3741_SPECTRUM_SAMPLES]; ///< FFT imaginary parts
+  uint8_t _level[24] = {0};             ///< Bar levels, matrix columns
+  uint8_t _peak[24] = {0};              ///< Peak levels, matrix columns
+  uint8_t _ring[24] = {0};              ///< Levels, ring pixels
+  uint8_t _floor = 80;                  ///< Level of empty bar
+  uint8_t _ceiling = 208;               ///< Level of full bar
+  uint8_t _barDecay = 24;               ///< Bar drop per process()
+  uint8_t _peakDecay = 6;               ///< Peak drop per process()
+};
+
+// TRIPLE BUFFERING --------------------------------------------------------
+
+/**************************************************************************/
+/*!
+    @brief  Class for handing frames from one core (drawing) to another
+            (transmitting over I2C) on dual-core boards like RP2040 and
+            ESP32, without locks or stalls. Drawing happens as usual in
+            the buffered object, then publish() copies it into one of three
+            internal frames. show() on the other core sends the newest
+            published frame. Neither side ever waits for the other; frames
+            published faster than they can be sent are simply skipped.
+            Uses about 1 KB RAM. Apart from publish(), drawing side must
+            not make any calls that talk to the chip (setLEDscaling(),
+            show() and so forth), those belong to the transmitting core.
+*/
+/**************************************************************************/
+class Adafruit_IS31FL3741_TripleBuffer {
+public:
+  Adafruit_IS31FL3741_TripleBuffer(Adafruit_IS31FL3741_buffered *display);
+  void publish(void);
+  bool show(void);
+  /*!
+    @brief    Check whether a frame has been published since last show().
+    @returns  bool  true if a new frame is waiting to be sent.
+  */
+  bool available(void) const { return _latest != _sent; }
+
+protected:
+  Adafruit_IS31FL3741_buffered *_display; ///< Object being drawn to
+
+  uint8_t _frame[3][352];    ///< Published frames, same layout as ledbuf
+  volatile uint8_t _latest;  ///< Newest frame index + sequence (drawing)
+  volatile uint8_t _reading; ///< Frame index being sent, 3 = none (sending)
+  uint8_t _sent;             ///< Value of _latest last sent (sending)
+  uint8_t _seq = 0;          ///< Publish counter (drawing)
+};
+
+// DELTA UPDATES -----------------------------------------------------------
+
+/**************************************************************************/
+/*!
+    @brief  Class for sending only the parts of a buffered object's LEDs
+            that changed since the last transfer, for mostly-static scenes
+            (clocks, gauges, status panels) or several independent pieces
+            of code each drawing their own region. Keeps a copy of what
+            was last sent, compares in 16-byte blocks, and sends just the
+            changed blocks. A generation counter lets code that draws note
+            that it did so with touch(), so a loop committing at a fixed
+            rate can skip even the comparison when nothing was touched.
+            Uses about 360 bytes RAM.
+*/
+/**************************************************************************/
+class Adafruit_IS31FL3741_DeltaShow {
+public:
+  Adafruit_IS31FL3741_DeltaShow(Adafruit_IS31FL3741_buffered *display);
+  bool show(void);
+  /*!
+    @brief  Note that the buffer was drawn to. Safe from interrupts: the
+            counter is a single byte, so reading or writing it can't be
+            torn, even on 8-bit AVR. If touch() is called from both an
+            interrupt and main code, an increment may occasionally be
+            lost, but changed() still reports true.
+  */
+  void touch(void) { _gen = _gen + 1; }
+  /*!
+    @brief    Check whether touch() was called since the last show().
+              Counter wraps, so exactly 256 touches would read as none.
+    @returns  bool  true if something may need sending.
+  */
+  bool changed(void) const { return _gen != _shownGen; }
+  /*!
+    @brief    Get generation counter, incremented by each touch().
+    @returns  uint8_t  Generation number, wraps around after 255.
+  */
+  uint8_t generation(void) const { return _gen; }
+  /*!
+    @brief  Forget what was last sent, so the next show() sends all
+            blocks, e.g. after the chip was reset or written elsewhere.
+  */
+  void invalidate(void) { _valid = false; }
+  /*!
+    @brief    Get number of 16-byte blocks sent by the last show().
+    @returns  uint8_t  Blocks sent, 0-23.
+  */
+  uint8_t blocksSent(void) const { return _blocks; }
+
+protected:
+  Adafruit_IS31FL3741_buffered *_display; ///< Object being drawn to
+
+  uint8_t _sent[351];        ///< LED data as last sent to the chip
+  volatile uint8_t _gen = 0; ///< Generation, bumped by touch()
+  uint8_t _shownGen = 0;     ///< Value of _gen at last show()
+  bool _valid = false;       ///< If false, _sent is unknown, send all
+  uint8_t _blocks = 0;       ///< Blocks sent by last show()
+};
+
+// FRAME PACING ------------------------------------------------------------
+
+#define IS3741_JITTER_BINS 8     ///< Histogram bins in IS3741_frameStats
+#define IS3741_QUALITY_LEVELS 6 ///< Adaptive quality steps, see setAdaptive()
+
+// Timing statistics gathered by Adafruit_IS31FL3741_FramePacer. All times
+// are in microseconds. Comparing renderAvg to showAvg tells whether a
+// sketch is CPU-bound (drawing) or bus-bound (I2C transfer).
+typedef struct {
+  uint32_t frames;    ///< Frames shown since reset()
+  uint32_t missed;    ///< Frames that ran past their period
+  uint32_t renderUs;  ///< Last frame's drawing time (between show() calls)
+  uint32_t showUs;    ///< Last frame's I2C transfer time
+  uint32_t renderAvg; ///< Drawing time, averaged over ~16 frames
+  uint32_t showAvg;   ///< Transfer time, averaged over ~16 frames
+  uint32_t renderMax; ///< Longest drawing time
+  uint32_t showMax;   ///< Longest transfer time
+  uint16_t fps;       ///< Frames shown over the last full second
+  /// Frame start lateness vs. schedule: bin 0 is under 64 us, each bin
+  /// after doubles that, last bin is 4096 us and up (incl. missed frames).
+  uint32_t jitter[IS3741_JITTER_BINS];
+} IS3741_frameStats;
+
+/**************************************************************************/
+/*!
+    @brief  Class for running a buffered display at a fixed frame rate.
+            Instead of drawing and show() followed by a fixed delay()
+            (which drifts with drawing load and transfer time), draw and
+            then call this object's show(). It transfers the frame and
+            sleeps just the remainder of the period. A frame that overruns
+            is counted as missed and the schedule restarts from there,
+            rather than rushing later frames to catch up.
+*/
+/**************************************************************************/
+class Adafruit_IS31FL3741_FramePacer {
+public:
+  Adafruit_IS31FL3741_FramePacer(Adafruit_IS31FL3741_buffered *display,
+                                 uint16_t fps = 60);
+  void setFPS(uint16_t fps);
+  bool show(void);
+  void reset(void);
+  void setAdaptive(bool on);
+  bool allowSmoothScale(void) const;
+  bool allowInterpolatedFrame(void) const;
+  bool allowRingUpdate(void) const;
+  /*!
+    @brief    Get timing statistics gathered by show().
+    @returns  const IS3741_frameStats*  Pointer to statistics.
+  */
+  const IS3741_frameStats *getStats(void) const { return &_stats; }
+  /*!
+    @brief    Get current adaptive quality level.
+    @returns  uint8_t  IS3741_QUALITY_LEVELS - 1 for full quality, down to
+                       0 for the most reduced. Always full if adaptive
+                       quality is off.
+  */
+  uint8_t getQuality(void) const { return _quality; }
+
+protected:
+  void adapt(bool missed);
+  Adafruit_IS31FL3741_buffered *_display; ///< Object being paced
+  IS3741_frameStats _stats;               ///< Results for getStats()
+
+  uint32_t _period;    ///< Microseconds per frame
+  uint32_t _start;     ///< Scheduled start of current frame
+  uint32_t _second;    ///< Start of current FPS window
+  uint32_t _renderSum; ///< renderAvg * 16, for smoothing
+  uint32_t _showSum;   ///< showAvg * 16, for smoothing
+  uint16_t _count;     ///< Frames in current FPS window
+  bool _running;       ///< false until first show() after reset()
+
+  uint16_t _upFrames;     ///< Frames with headroom needed to step up
+  uint16_t _sinceUp;      ///< Frames since last step up
+  uint16_t _under;        ///< Consecutive frames with headroom
+  uint8_t _over;          ///< Consecutive frames over budget
+  uint8_t _holdoff;       ///< Frames to let averages settle after a step
+  uint8_t _quality;       ///< Current level, see getQuality()
+  bool _adaptive = false; ///< Set by setAdaptive()
+};
+
+// TRANSACTION TRACING -----------------------------------------------------
+
+#define IS3741_TRACE_READ 0x01 ///< Trace record flag: register read
+#define IS3741_TRACE_FAIL 0x02 ///< Trace record flag: not acknowledged
+
+/**************************************************************************/
+/*!
+    @brief  Base class for anything that receives a record of each I2C
+            transaction made by an Adafruit_IS31FL3741 object, once passed
+            to its setTrace() function. Subclasses below capture records
+            to RAM or a Print stream, or model the chip's registers.
+            When stored or sent, records use a compact binary format, all
+            values little-endian: 32-bit time (micros()), 8-bit I2C
+            address, 8-bit flags (IS3741_TRACE_*), 16-bit data length,
+            then data: register address followed by values written (or,
+            for reads, values read).
+*/
+/**************************************************************************/
+class Adafruit_IS31FL3741_TraceSink {
+public:
+  /*!
+    @brief  Receive one transaction record.
+    @param  time   micros() when the transaction started.
+    @param  addr   7-bit I2C address.
+    @param  flags  IS3741_TRACE_READ and/or IS3741_TRACE_FAIL bits.
+    @param  data   Register address followed by values.
+    @param  len    Length of data, including register address.
+  */
+  virtual void record(uint32_t time, uint8_t addr, uint8_t flags,
+                      const uint8_t *data, uint16_t len) = 0;
+  /*!
+    @brief  Destructor, virtual so sinks deleted through a base pointer
+            clean up properly.
+  */
+  virtual ~Adafruit_IS31FL3741_TraceSink() {}
+};
+
+/**************************************************************************/
+/*!
+    @brief  Trace sink that keeps the most recent records in a RAM ring
+            buffer (provided by the sketch, any size), discarding the
+            oldest whole records when full. Can be dumped later in binary
+            format (e.g. to an SD file for replay) or as readable text.
+*/
+/**************************************************************************/
+class Adafruit_IS31FL3741_TraceBuffer : public Adafruit_IS31FL3741_TraceSink {
+public:
+  Adafruit_IS31FL3741_TraceBuffer(uint8_t *buf, uint16_t size);
+  void record(uint32_t time, uint8_t addr, uint8_t flags, const uint8_t *data,
+              uint16_t len);
+  void clear(void);
+  void dump(Print *out) const;
+  void list(Print *out) const;
+  /*!
+    @brief    Get number of records currently held.
+    @returns  uint16_t  Record count.
+  */
+  uint16_t count(void) const { return _records; }
+  /*!
+    @brief    Get number of records discarded (to make room, or too large
+              for the buffer) since last clear().
+    @returns  uint32_t  Discarded record count.
+  */
+  uint32_t dropped(void) const { return _dropped; }
+
+protected:
+  uint8_t peek(uint16_t offset) const;
+  uint8_t *_buf;     ///< Ring buffer, supplied by sketch
+  uint16_t _size;    ///< Size of _buf in bytes
+  uint16_t _head;    ///< Index of oldest record in _buf
+  uint16_t _used;    ///< Bytes in use
+  uint16_t _records; ///< Records in use
+  uint32_t _dropped; ///< Records discarded since clear()
+};
+
+/**************************************************************************/
+/*!
+    @brief  Trace sink that writes each record (binary format) to a Print
+            stream as it happens, e.g. an SD card File, or Serial if
+            piped to a file on the host. Slows things down by the time it
+            takes to write, so for capturing rather than measuring.
+*/
+/**************************************************************************/
+class Adafruit_IS31FL3741_TracePrint : public Adafruit_IS31FL3741_TraceSink {
+public:
+  /*!
+    @brief  Constructor for trace-to-Print sink.
+    @param  out  Pointer to Print stream, e.g. &Serial or &file.
+  */
+  Adafruit_IS31FL3741_TracePrint(Print *out) : _out(out) {}
+  void record(uint32_t time, uint8_t addr, uint8_t flags, const uint8_t *data,
+              uint16_t len);
+
+protected:
+  Print *_out; ///< Where records go
+};
+
+/**************************************************************************/
+/*!
+    @brief  Trace sink that models the IS31FL3741's page & register state
+            as a chip would receive the same writes: PWM and scaling for
+            all 351 LEDs, page 4 function registers, the selected page and
+            the command register lock. Lets a captured trace be checked
+            offline for what actually reached the LEDs, and counts writes
+            that a real chip would reject or ignore. About 770 bytes RAM.
+*/
+/**************************************************************************/
+class Adafruit_IS31FL3741_Model : public Adafruit_IS31FL3741_TraceSink {
+public:
+  /*!
+    @brief  Constructor for register model, starts in power-on state.
+  */
+  Adafruit_IS31FL3741_Model(void) { reset(); }
+  void record(uint32_t time, uint8_t addr, uint8_t flags, const uint8_t *data,
+              uint16_t len);
+  void reset(void);
+  uint8_t getPWM(uint16_t lednum) const;
+  uint8_t getScaling(uint16_t lednum) const;
+  uint8_t getRegister(uint8_t reg) const;
+  /*!
+    @brief    Get the page the modeled chip currently has selected.
+    @returns  int8_t  Page 0-4, or -1 if none selected since reset.
+  */
+  int8_t getPage(void) const { return _page; }
+  /*!
+    @brief    Get number of writes a real chip would reject or ignore
+              (page select without unlock, invalid page or register).
+    @returns  uint32_t  Error count.
+  */
+  uint32_t errors(void) const { return _errors; }
+
+protected:
+  void resetRegisters(void);
+  uint8_t _pwm[351];     ///< PWM registers (pages 0 & 1)
+  uint8_t _scaling[351]; ///< Scaling registers (pages 2 & 3)
+  uint8_t _func[0x40];   ///< Function registers (page 4)
+  int8_t _page;          ///< Selected page, -1 = none
+  bool _unlocked;        ///< Command register lock state
+  uint32_t _errors;      ///< Rejected writes
+};
+
+/**************************************************************************/
+/*!
+    @brief  Trace sink that computes how long each transaction occupies
+            the I2C bus, for predicting frame rates without hardware (or
+            for boards, clock rates and buffer sizes other than the one
+            at hand). Bit-level: START, address and data bytes with ACK
+            bits, repeated START for reads, STOP and bus-free time, plus
+            an optional per-transaction software overhead. Writes longer
+            than the modeled buffer size are split as the library would,
+            so a trace captured on one board can be costed for another.
+            Static functions predict common operations directly.
+*/
+/**************************************************************************/
+class Adafruit_IS31FL3741_BusModel : public Adafruit_IS31FL3741_TraceSink {
+public:
+  Adafruit_IS31FL3741_BusModel(uint32_t clock = 400000,
+                               uint16_t bufferSize = 32);
+  void record(uint32_t time, uint8_t addr, uint8_t flags, const uint8_t *data,
+              uint16_t len);
+  void reset(void);
+  /*!
+    @brief  Set software overhead added to each transaction, e.g. time
+            the I2C driver takes between transfers on a given board.
+    @param  us  Microseconds per transaction.
+  */
+  void setOverhead(uint16_t us) { _overhead = us; }
+  uint32_t busMicros(void) const;
+  uint32_t pageMicros(void) const;
+  /*!
+    @brief    Get number of transactions modeled since reset(), after any
+              splitting for buffer size.
+    @returns  uint32_t  Transaction count.
+  */
+  uint32_t transactions(void) const { return _transactions; }
+  /*!
+    @brief    Get number of page selects modeled since reset() (each is
+              an unlock plus a page write).
+    @returns  uint32_t  Page select count.
+  */
+  uint32_t pageSelects(void) const { return _pageSelects; }
+  /*!
+    @brief    Get number of payload bytes (register address and data, not
+              I2C address) modeled since reset().
+    @returns  uint32_t  Byte count.
+  */
+  uint32_t bytes(void) const { return _bytes; }
+
+  static uint32_t writeBits(uint16_t len, uint16_t bufferSize = 32);
+  static uint32_t readBits(uint16_t len);
+  static uint32_t bitsToMicros(uint32_t bits, uint32_t clock);
+  static uint32_t predictShow(uint32_t clock, uint16_t bufferSize = 32);
+  static uint32_t predictFill(uint32_t clock);
+  static uint32_t predictPixels(uint32_t clock, uint16_t n);
+
+protected:
+  uint32_t _clock;        ///< Modeled I2C clock, Hz
+  uint32_t _bits;         ///< Total bit times since reset()
+  uint32_t _pageBits;     ///< Bit times spent on page selects
+  uint32_t _transactions; ///< Transactions since reset()
+  uint32_t _pageSelects;  ///< Page selects since reset()
+  uint32_t _bytes;        ///< Payload bytes since reset()
+  uint16_t _bufferSize;   ///< Modeled maxBufferSize()
+  uint16_t _overhead = 0; ///< Software microseconds per transaction
+};
+
+/**************************************************************************/
+/*!
+    @brief  Class for playing back a binary trace (as written by
+            Adafruit_IS31FL3741_TracePrint or TraceBuffer::dump()) from
+            any Stream: an SD card File, Serial from a host, etc. Records
+            can be sent to real hardware, optionally at the original pace,
+            or to any trace sink such as Adafruit_IS31FL3741_Model to
+            reproduce chip state. Uses about 270 bytes RAM.
+*/
+/**************************************************************************/
+class Adafruit_IS31FL3741_TraceReplay {
+public:
+  /*!
+    @brief  Constructor for trace playback.
+    @param  in  Pointer to Stream containing binary trace records.
+  */
+  Adafruit_IS31FL3741_TraceReplay(Stream *in) : _in(in) {}
+  bool next(void);
+  uint32_t replay(Adafruit_IS31FL3741 *chip, bool realtime = false);
+  uint32_t replay(Adafruit_IS31FL3741_TraceSink *sink);
+  /*!
+    @brief    Get time of record most recently read by next().
+    @returns  uint32_t  micros() value when transaction was captured.
+  */
+  uint32_t time(void) const { return _time; }
+  /*!
+    @brief    Get I2C address of record most recently read by next().
+    @returns  uint8_t  7-bit I2C address.
+  */
+  uint8_t address(void) const { return _addr; }
+  /*!
+    @brief    Get flags of record most recently read by next().
+    @returns  uint8_t  IS3741_TRACE_READ and/or IS3741_TRACE_FAIL bits.
+  */
+  uint8_t flags(void) const { return _flags; }
+  /*!
+    @brief    Get data of record most recently read by next().
+    @returns  const uint8_t*  Register address followed by values.
+  */
+  const uint8_t *data(void) const { return _data; }
+  /*!
+    @brief    Get data length of record most recently read by next().
+    @returns  uint16_t  Length, including register address.
+  */
+  uint16_t length(void) const { return _len; }
+
+protected:
+  bool readBytes(uint8_t *buf, uint16_t len);
+  Stream *_in;        ///< Where records come from
+  uint32_t _time = 0; ///< Time of current record
+  uint16_t _len = 0;  ///< Data length of current record
+  uint8_t _addr = 0;  ///< I2C address of current record
+  uint8_t _flags = 0; ///< Flags of current record
+  uint8_t _data[256]; ///< Data of current record
+};
+
+// DMX OVER NETWORK (ART-NET, E1.31) ---------------------------------------
+
+#define IS3741_ARTNET_PORT 6454 ///< UDP port for Art-Net
+#define IS3741_E131_PORT 5568   ///< UDP port for E1.31 (sACN)
+#define IS3741_DMX_MAPS 16      ///< Max entries in an IS3741_dmxMap list
+
+// One entry of the mapping from DMX universes to LED buffers, passed as
+// an array to the Adafruit_IS31FL3741_DMX constructor. Channels are copied
+// as-is into getBuffer() order (the chip's register order), no remapping.
+typedef struct {
+  uint16_t universe; ///< Art-Net port-address or E1.31 universe
+  uint16_t channel;  ///< First DMX channel used, 1-512
+  uint16_t count;    ///< Number of channels (LED elements) to copy
+  uint16_t offset;   ///< First getBuffer() index written, 0-350
+  /// Buffered object (e.g. Adafruit_IS31FL3741_QT_buffered) to write
+  Adafruit_IS31FL3741_buffered *display;
+} IS3741_dmxMap;
+
+/**************************************************************************/
+/*!
+    @brief  Class for receiving DMX lighting data from show-control software
+            over Art-Net or E1.31 (sACN), and copying it into the LED
+            buffers of one or more buffered objects per a mapping table.
+            Networking is left to the sketch (WiFiUDP, EthernetUDP, etc.),
+            which passes each received packet to handlePacket(). Each
+            object's show() is called once per frame: when every universe
+            mapped to it has arrived, or on a sync packet if the sender
+            uses them. Late packets (older sequence numbers) are dropped,
+            and if a universe goes missing, the partial frame is shown
+            just once when that universe's next frame starts.
+*/
+/**************************************************************************/
+class Adafruit_IS31FL3741_DMX {
+public:
+  Adafruit_IS31FL3741_DMX(const IS3741_dmxMap *map, uint8_t count);
+  uint8_t handlePacket(const uint8_t *data, uint16_t len);
+  uint8_t commit(void);
+  /*!
+    @brief    Get number of DMX data packets accepted.
+    @returns  uint32_t  Packet count.
+  */
+  uint32_t packets(void) const { return _packets; }
+  /*!
+    @brief    Get number of DMX data packets dropped as late or repeated.
+    @returns  uint32_t  Packet count.
+  */
+  uint32_t dropped(void) const { return _dropped; }
+  /*!
+    @brief    Get number of show() calls made, across all objects.
+    @returns  uint32_t  Frame count.
+  */
+  uint32_t frames(void) const { return _frames; }
+  /*!
+    @brief    Get number of show() calls made with a universe missing.
+    @returns  uint32_t  Frame count.
+  */
+  uint32_t partial(void) const { return _partial; }
+
+protected:
+  uint8_t receive(uint16_t universe, int16_t seq, const uint8_t *dmx,
+                  uint16_t len);
+  uint8_t sync(void);
+  uint8_t showFrames(uint16_t mask, bool all);
+  uint16_t group(uint8_t i) const;
+  const IS3741_dmxMap *_map;     ///< Mapping table
+  uint8_t _count;                ///< Entries in _map, up to IS3741_DMX_MAPS
+  uint16_t _received = 0;        ///< Entries with data since last show()
+  uint16_t _seen = 0;            ///< Entries with a sequence number yet
+  uint8_t _seq[IS3741_DMX_MAPS]; ///< Last sequence number per entry
+  uint32_t _lastSync = 0;        ///< millis() of last sync packet
+  bool _synced = false;          ///< If set, show() waits for sync packets
+  uint32_t _packets = 0;         ///< Data packets accepted
+  uint32_t _dropped = 0;         ///< Data packets dropped (late/repeated)
+  uint32_t _frames = 0;          ///< show() calls
+  uint32_t _partial = 0;         ///< show() calls with data missing
+};
+
+// SERIAL FRAME PROTOCOL ---------------------------------------------------
+
+#define IS3741_FRAME_FULL 'F'    ///< Message type: all 351 LED elements
+#define IS3741_FRAME_DELTA 'D'   ///< Message type: runs of LED elements
+#define IS3741_FRAME_PALETTE 'P' ///< Message type: palette colors
+#define IS3741_FRAME_INDEXED 'I' ///< Message type: 4-bit palette pixels
+#define IS3741_FRAME_ACK 'K'     ///< Reply to good message, see setAck()
+#define IS3741_FRAME_NAK 'E'     ///< Reply to bad message, see setAck()
+#define IS3741_PALETTE_SIZE 16   ///< Colors in FrameReceiver palette
+
+/**************************************************************************/
+/*!
+    @brief  Class for receiving LED frames from a computer over any Stream
+            (USB serial, UART, etc.) in a framed, checksummed binary
+            format that decodes straight into the LED buffer, with no
+            intermediate copy. Each message is:
+              'I', 'S'  Sync bytes
+              type      One of the IS3741_FRAME_* message types
+              length    Payload length, 16-bit little-endian
+              payload   See below
+              checksum  Fletcher-16 (modulo 255) of type, length and
+                        payload bytes, sent as sum1 then sum2
+            FULL payload is 351 LED elements in getBuffer() order. DELTA
+            is any number of runs, each a 16-bit little-endian getBuffer()
+            index, 8-bit count and that many values. PALETTE is a first
+            palette index, then any number of R,G,B byte triplets. INDEXED
+            is width() * height() 4-bit palette indices, two per byte (high
+            nibble first), rows top to bottom. FULL, DELTA and INDEXED call
+            show() if the checksum is good. As data goes straight into the
+            buffer, a bad one may leave part of a frame there, unshown.
+*/
+/**************************************************************************/
+class Adafruit_IS31FL3741_FrameReceiver {
+public:
+  Adafruit_IS31FL3741_FrameReceiver(
+      Adafruit_IS31FL3741_colorGFX_buffered *display, Stream *in);
+  uint8_t poll(void);
+  /*!
+    @brief  Enable or disable a one-byte reply after each message,
+            IS3741_FRAME_ACK if good or IS3741_FRAME_NAK if not, so the
+            sender can pace itself. Off by default.
+    @param  on  true to enable, false to disable.
+  */
+  void setAck(bool on) { _ack = on; }
+  /*!
+    @brief    Get number of messages received with a good checksum.
+    @returns  uint32_t  Message count.
+  */
+  uint32_t frames(void) const { return _frames; }
+  /*!
+    @brief    Get number of messages rejected (bad checksum, type or
+              length).
+    @returns  uint32_t  Message count.
+  */
+  uint32_t errors(void) const { return _errors; }
+
+protected:
+  uint8_t parse(uint8_t c);
+  bool start(void);
+  void payload(uint8_t c);
+  void reply(bool good);
+  Adafruit_IS31FL3741_colorGFX_buffered *_display; ///< Object being drawn to
+  Stream *_in;                                     ///< Where messages come from
+
+  uint8_t _palette[IS3741_PALETTE_SIZE * 3] = {0}; ///< R,G,B per color
+  uint32_t _frames = 0; ///< Good messages
+  uint32_t _errors = 0; ///< Rejected messages
+  uint16_t _len = 0;    ///< Payload length of current message
+  uint16_t _pos = 0;    ///< Payload bytes received so far
+  uint16_t _arg = 0;    ///< Delta buffer index, or palette element index
+  uint8_t _run = 0;     ///< Delta values left in current run
+  uint8_t _sub = 0;     ///< Delta run header position, 0-3
+  uint8_t _state = 0;   ///< Parser state, 0 = waiting for sync
+  uint8_t _type = 0;    ///< Type of current message
+  uint8_t _sum1 = 0;    ///< Fletcher-16 running sums
+  uint8_t _sum2 = 0;    ///< (second of the two)
+  uint8_t _check = 0;   ///< First checksum byte received
+  bool _ack = false;    ///< If set, reply after each message
+};
+
+// BYTECODE PROGRAMS -------------------------------------------------------
+
+// Opcodes for Adafruit_IS31FL3741_VM. Stack effects are shown as (inputs
+// -- outputs), rightmost input on top of stack. Colors are 24-bit RGB888.
+// Values are 32-bit signed; arithmetic wraps around on overflow.
+// Programs are just byte arrays; the IS3741_PUSH() and similar macros
+// below write the multi-byte instructions, e.g.:
+//   const uint8_t PROGMEM prog[] = { IS3741_PUSH(0), IS3741_OP_FILL,
+//                                    IS3741_OP_SHOW };
+typedef enum {
+  IS3741_OP_HALT = 0, ///< ( -- ) Stop, until next load()
+  IS3741_OP_PUSH8,    ///< ( -- n ) Next byte, signed
+  IS3741_OP_PUSH16,   ///< ( -- n ) Next 2 bytes, little-endian, signed
+  IS3741_OP_PUSH24,   ///< ( -- n ) Next 3 bytes, little-endian, unsigned
+  IS3741_OP_DUP,      ///< ( a -- a a )
+  IS3741_OP_DROP,     ///< ( a -- )
+  IS3741_OP_SWAP,     ///< ( a b -- b a )
+  IS3741_OP_OVER,     ///< ( a b -- a b a )
+  IS3741_OP_LOAD,     ///< ( -- n ) Variable whose number is next byte
+  IS3741_OP_STORE,    ///< ( n -- ) Variable whose number is next byte
+  IS3741_OP_ADD,      ///< ( a b -- a+b )
+  IS3741_OP_SUB,      ///< ( a b -- a-b )
+  IS3741_OP_MUL,      ///< ( a b -- a*b )
+  IS3741_OP_DIV,      ///< ( a b -- a/b ) Divide by 0 gives 0
+  IS3741_OP_MOD,      ///< ( a b -- a%b ) Modulo 0 gives 0
+  IS3741_OP_AND,      ///< ( a b -- a&b )
+  IS3741_OP_OR,       ///< ( a b -- a|b )
+  IS3741_OP_XOR,      ///< ( a b -- a^b )
+  IS3741_OP_SHL,      ///< ( a b -- a<<b )
+  IS3741_OP_SHR,      ///< ( a b -- a>>b ) Arithmetic shift
+  IS3741_OP_LT,       ///< ( a b -- a<b ) 1 if true, else 0
+  IS3741_OP_EQ,       ///< ( a b -- a==b ) 1 if true, else 0
+  IS3741_OP_NOT,      ///< ( a -- !a ) 1 if a is 0, else 0
+  IS3741_OP_REPEAT,   ///< ( n -- ) Run code up to NEXT n times
+  IS3741_OP_NEXT,     ///< ( -- ) End of REPEAT loop
+  IS3741_OP_INDEX,    ///< ( -- i ) Innermost REPEAT count, from 0
+  IS3741_OP_IF,       ///< ( n -- ) Run code up to ENDIF only if n != 0
+  IS3741_OP_ENDIF,    ///< ( -- ) End of IF
+  IS3741_OP_SIN,      ///< ( angle -- sin ) As sin16(), +/-32767
+  IS3741_OP_RAND,     ///< ( -- n ) Random, 0-65535
+  IS3741_OP_FRAME,    ///< ( -- n ) Number of SHOWs so far
+  IS3741_OP_HSV,      ///< ( hue sat val -- color ) As ColorHSV()
+  IS3741_OP_RGB,      ///< ( r g b -- color )
+  IS3741_OP_FILL,     ///< ( color -- ) Whole matrix
+  IS3741_OP_PIXEL,    ///< ( x y color -- )
+  IS3741_OP_HLINE,    ///< ( x y w color -- ) Horizontal span, w > 0
+  IS3741_OP_RECT,     ///< ( x y w h color -- ) Filled rect, w & h > 0
+  IS3741_OP_RING,     ///< ( side n color -- ) Ring pixel, side 0=left
+  IS3741_OP_RINGFILL, ///< ( side color -- ) Whole ring, side 0=left
+  IS3741_OP_DIM,      ///< ( level -- ) As dim(), whole buffer
+  IS3741_OP_BLUR,     ///< ( amount -- ) As blur()
+  IS3741_OP_WAIT,     ///< ( ms -- ) Pause program, run() returns
+  IS3741_OP_SHOW,     ///< ( -- ) Send frame, run() returns
+  IS3741_OP_COUNT     ///< Number of opcodes, not an instruction
+} IS3741_opcode;
+
+/// Instruction to push a 16-bit signed value n
+#define IS3741_PUSH(n) IS3741_OP_PUSH16, (uint8_t)(n), (uint8_t)((n) >> 8)
+/// Instruction to push a 24-bit RGB888 color c (e.g. 0xFF8000)
+#define IS3741_COLOR(c)                                                        \
+  IS3741_OP_PUSH24, (uint8_t)(c), (uint8_t)((c) >> 8), (uint8_t)((c) >> 16)
+/// Instruction to push the value of variable v (0-7)
+#define IS3741_LOAD(v) IS3741_OP_LOAD, (v)
+/// Instruction to pop a value into variable v (0-7)
+#define IS3741_STORE(v) IS3741_OP_STORE, (v)
+
+// Values returned by Adafruit_IS31FL3741_VM::run()
+typedef enum {
+  IS3741_VM_FRAME,  ///< SHOW executed
+  IS3741_VM_WAIT,   ///< WAIT in progress
+  IS3741_VM_BUDGET, ///< Instruction budget used up
+  IS3741_VM_HALT,   ///< Program stopped (HALT, or nothing loaded)
+  IS3741_VM_ERROR,  ///< Program stopped on an error, see pc()
+} IS3741_vmStatus;
+
+#define IS3741_VM_STACK 16 ///< Stack depth of Adafruit_IS31FL3741_VM
+#define IS3741_VM_VARS 8   ///< Variables in Adafruit_IS31FL3741_VM
+#define IS3741_VM_LOOPS 4  ///< REPEAT nesting depth
+
+/**************************************************************************/
+/*!
+    @brief  Class for running small stack-based bytecode programs that
+            draw on a buffered matrix (and optionally EyeLights rings),
+            so animations can be changed without reflashing: programs can
+            live in PROGMEM, or be loaded from any Stream (serial, an SD
+            card file, etc.) into RAM. Each instruction maps onto one of
+            the library's own drawing functions, so drawing runs at native
+            speed; only the control flow is interpreted. When the end of
+            the program is reached it starts over from the beginning;
+            variables persist. See IS3741_opcode for instructions.
+*/
+/**************************************************************************/
+class Adafruit_IS31FL3741_VM {
+public:
+  Adafruit_IS31FL3741_VM(Adafruit_IS31FL3741_colorGFX_buffered *display);
+  void setRings(Adafruit_EyeLights_Ring_buffered *left,
+                Adafruit_EyeLights_Ring_buffered *right);
+  void load(const uint8_t *program, uint16_t len, bool progmem = false);
+  uint16_t load(Stream *in, uint8_t *buf, uint16_t size);
+  IS3741_vmStatus run(uint16_t budget = 1000);
+  /*!
+    @brief    Get program counter, e.g. where an error happened.
+    @returns  uint16_t  Byte offset into program.
+  */
+  uint16_t pc(void) const { return _pc; }
+  /*!
+    @brief    Get total instructions executed since load(), e.g. to gauge
+              the cost of a program against a per-frame budget.
+    @returns  uint32_t  Instruction count.
+  */
+  uint32_t instructions(void) const { return _count; }
+
+protected:
+  uint8_t fetch(void);
+  bool skip(uint8_t open, uint8_t close);
+  Adafruit_IS31FL3741_colorGFX_buffered *_display; ///< Object to draw into
+  Adafruit_EyeLights_Ring_buffered *_ring[2] = {NULL, NULL}; ///< L, R rings
+
+  const uint8_t *_prog = NULL;              ///< Program bytes
+  uint16_t _len = 0;                        ///< Program length
+  uint16_t _pc = 0;                         ///< Program counter
+  int32_t _stack[IS3741_VM_STACK];          ///< Value stack
+  int32_t _var[IS3741_VM_VARS];             ///< Variables
+  uint16_t _loopPC[IS3741_VM_LOOPS];        ///< REPEAT loop start addresses
+  uint16_t _loopIndex[IS3741_VM_LOOPS];     ///< REPEAT loop counters
+  uint16_t _loopCount[IS3741_VM_LOOPS];     ///< REPEAT loop lengths
+  uint32_t _wake = 0;                       ///< millis() when WAIT ends
+  uint32_t _count = 0;                      ///< Instructions executed
+  uint32_t _seed = 0x2545F491;              ///< Xorshift PRNG state, never 0
+  uint16_t _frame = 0;                      ///< SHOWs executed
+  uint8_t _sp = 0;                          ///< Stack depth
+  uint8_t _lp = 0;                          ///< REPEAT nesting depth
+  bool _progmem = false;                    ///< If set, _prog is in PROGMEM
+  bool _waiting = false;                    ///< If set, in a WAIT
+  IS3741_vmStatus _status = IS3741_VM_HALT; ///< HALT or ERROR once stopped
+};
+
+// MIRRORED DISPLAYS -------------------------------------------------------
+
+#define IS3741_MIRROR_MAX 4    ///< Most members in one mirror group
+#define IS3741_MIRROR_CHUNK 32 ///< Bytes per I2C write to rotated members
+
+// One display in an Adafruit_IS31FL3741_Mirror group. Used internally.
+typedef struct {
+  Adafruit_IS31FL3741 *display; ///< Member's (unbuffered) driver object
+  uint8_t rotation;             ///< Mounting rotation vs source, 0-3
+  uint8_t element[3];           ///< Source mapPixel() slot for member R,G,B
+  bool direct;                  ///< If set, buffer is sent unaltered
+} IS3741_mirrorMember;
+
+/**************************************************************************/
+/*!
+    @brief  Class for showing one buffered object's image on several
+            boards of the same type at once (matching badges, both sides
+            of a sign, etc.). Drawing happens once, in the buffered object,
+            and show() sends that one buffer to it and to each member.
+            Members are plain unbuffered Adafruit_IS31FL3741 objects, so
+            each costs a few bytes instead of a 352-byte buffer. A member
+            may be mounted rotated, or wired with a different color order,
+            from the source board; its data is then rearranged a chunk at a
+            time as it's sent (still no extra buffer, but some CPU time,
+            a few milliseconds per member on AVR).
+*/
+/**************************************************************************/
+class Adafruit_IS31FL3741_Mirror {
+public:
+  Adafruit_IS31FL3741_Mirror(Adafruit_IS31FL3741_colorGFX_buffered *source);
+  bool add(Adafruit_IS31FL3741 *member, uint8_t rotation = 0);
+  bool add(Adafruit_IS31FL3741 *member, uint8_t rotation, IS3741_order order);
+  void show(void);
+  /*!
+    @brief    Get number of members added (not counting the source).
+    @returns  uint8_t  Member count, 0 to IS3741_MIRROR_MAX.
+  */
+  uint8_t members(void) const { return _count; }
+
+protected:
+  void stream(const IS3741_mirrorMember *m);
+  static void streamChunk(uint8_t *data, uint16_t start, uint8_t len,
+                          void *arg);
+  Adafruit_IS31FL3741_colorGFX_buffered *_source; ///< Object being drawn to
+  IS3741_mirrorMember _member[IS3741_MIRROR_MAX]; ///< Displays to copy to
+  uint8_t _count = 0;                             ///< Members added
+};
+
+// HARDWARE BLINK ----------------------------------------------------------
+
+/**************************************************************************/
+/*!
+    @brief  Class for blinking or strobing a whole display by toggling the
+            chip's shutdown bit, rather than clearing and redrawing all
+            the LEDs. Each on/off edge is a single 2-byte register write
+            if nothing else used the chip since the last edge; if show()
+            or similar ran in between, the edge must first unlock and
+            re-select page 4, 3 short writes in all. Either way it's far
+            less than redrawing, and LED data (and any buffer) is left
+            intact throughout, so drawing and show() can carry on while
+            blinking.
+*/
+/**************************************************************************/
+class Adafruit_IS31FL3741_Blink {
+public:
+  Adafruit_IS31FL3741_Blink(Adafruit_IS31FL3741 *display);
+  void start(uint16_t period, uint8_t duty = 128);
+  void stop(void);
+  bool poll(void);
+  /*!
+    @brief    Check whether display is in the lit part of the cycle.
+    @returns  bool  true if lit (or not blinking).
+  */
+  bool isLit(void) const { return _lit; }
+
+protected:
+  Adafruit_IS31FL3741 *_display; ///< Object being blinked
+  uint32_t _start = 0;           ///< millis() at start()
+  uint16_t _period = 0;          ///< Cycle length in ms, 0 if stopped
+  uint16_t _onTime = 0;          ///< Lit part of cycle in ms
+  bool _lit = true;              ///< Current state of display
+};
+
 #endif // _ADAFRUIT_IS31FL3741_H_
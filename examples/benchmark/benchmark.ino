@@ -0,0 +1,178 @@
+// Performance regression check for the IS31FL3741 library. Runs a set of
+// workloads (show(), fills, direct and buffered drawing, effects, scaling)
+// and prints one machine-readable CSV line each: time per operation in
+// nanoseconds, I2C payload bytes and transactions (from a BusModel trace
+// sink, so these are exact and the same on any board), modeled bus time
+// at 400 KHz, and the static size of the objects involved (sizeof plus
+// any canvas -- not a measured peak, stack use isn't included). Each is
+// compared with the baseline table below, and a final RESULT line reads
+// PASS, FAIL or NO_BASELINE, for a test runner watching the serial port
+// to act on.
+// Bus bytes and transactions must not increase at all. Times may vary by
+// TIME_TOLERANCE percent. Time baselines depend on the board, so none are
+// supplied: a workload without one reports NO_BASELINE (never PASS), and
+// so does RESULT unless something outright failed. Run this once on your
+// reference board with known-good code, paste the "# Measured ns" times
+// into the table, and from then on slowdowns are caught.
+// No IS31FL3741 needs to be connected. If one is, the bus workloads'
+// times include real transfers, otherwise just failed (NAK) ones.
+
+#include <Adafruit_IS31FL3741.h>
+
+// Some boards have just one I2C interface, but some have more...
+TwoWire *i2c = &Wire; // e.g. change this to &Wire1 for QT Py RP2040
+
+#define ITERATIONS 16     // Times each workload runs for timing
+#define TIME_TOLERANCE 10 // Percent slower than baseline that's allowed
+
+Adafruit_IS31FL3741_QT_buffered qt;
+Adafruit_IS31FL3741_QT qtDirect;
+Adafruit_EyeLights_buffered glasses(true); // With canvas for scale()
+Adafruit_IS31FL3741_Effects effects(&qt);
+Adafruit_IS31FL3741_BusModel model(400000, 32);
+IS3741_affine xform;
+
+// 8x8 RGB565 bitmap for drawAffine()
+const uint16_t PROGMEM bitmap[8 * 8] = {
+    0xF800, 0xF800, 0xFFE0, 0xFFE0, 0x07E0, 0x07E0, 0x001F, 0x001F,
+    0xF800, 0x0000, 0x0000, 0xFFE0, 0x07E0, 0x0000, 0x0000, 0x001F,
+    0xFFE0, 0x0000, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0000, 0x07E0,
+    0xFFE0, 0xFFE0, 0xFFFF, 0xF81F, 0xF81F, 0xFFFF, 0x07E0, 0x07E0,
+    0x07E0, 0x07E0, 0xFFFF, 0xF81F, 0xF81F, 0xFFFF, 0xFFE0, 0xFFE0,
+    0x07E0, 0x0000, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0000, 0xFFE0,
+    0x001F, 0x0000, 0x0000, 0x07E0, 0xFFE0, 0x0000, 0x0000, 0xF800,
+    0x001F, 0x001F, 0x07E0, 0x07E0, 0xFFE0, 0xFFE0, 0xF800, 0xF800,
+};
+
+void runShow(void) { qt.show(); }
+void runFillDirect(void) { qtDirect.fill(0); }
+void runPixelsDirect(void) {
+  for (int y = 0; y < qtDirect.height(); y++) {
+    for (int x = 0; x < qtDirect.width(); x++) {
+      qtDirect.drawPixel(x, y, x * 2749 + y * 7919);
+    }
+  }
+}
+void runPixelsBuffered(void) {
+  for (int y = 0; y < qt.height(); y++) {
+    for (int x = 0; x < qt.width(); x++) {
+      qt.drawPixel(x, y, x * 2749 + y * 7919);
+    }
+  }
+}
+void runFillBuffered(void) { qt.fill(0x1234); }
+void runBlur(void) { qt.blur(); }
+void runPlasma(void) { effects.plasma(); }
+void runAffine(void) { qt.drawAffine(bitmap, 8, 8, &xform, true); }
+void runScaleSmooth(void) { glasses.scale(true); }
+void runScalePoint(void) { glasses.scale(false); }
+
+typedef struct {
+  const char *name;   // Workload name in CSV output
+  void (*run)(void);  // Function that does one operation
+  uint16_t ram;       // Static size of the objects involved, bytes
+  uint32_t baseNs;    // Baseline nanoseconds/op, 0 = none (NO_BASELINE)
+  uint16_t baseBytes; // Baseline I2C payload bytes/op
+  uint16_t baseTx;    // Baseline I2C transactions/op
+} Workload;
+
+#define CANVAS_RAM (54 * 15 * 2) // EyeLights 3X canvas, heap
+Workload workloads[] = {
+    // Name, function, static RAM, baseline ns, bytes, transactions
+    {"show", runShow, sizeof qt, 0, 371, 16},
+    {"fill_direct", runFillDirect, sizeof qtDirect, 0, 754, 377},
+    {"pixels_direct", runPixelsDirect, sizeof qtDirect, 0, 750, 375},
+    {"pixels_buffered", runPixelsBuffered, sizeof qt, 0, 0, 0},
+    {"fill_buffered", runFillBuffered, sizeof qt, 0, 0, 0},
+    {"blur", runBlur, sizeof qt, 0, 0, 0},
+    {"plasma", runPlasma, sizeof qt + sizeof effects, 0, 0, 0},
+    {"affine", runAffine, sizeof qt, 0, 0, 0},
+    {"scale_smooth", runScaleSmooth, sizeof glasses + CANVAS_RAM, 0, 0, 0},
+    {"scale_point", runScalePoint, sizeof glasses + CANVAS_RAM, 0, 0, 0},
+};
+#define NUM_WORKLOADS (sizeof workloads / sizeof workloads[0])
+
+uint32_t measuredNs[NUM_WORKLOADS];
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) delay(10); // Wait for Serial Monitor on native USB boards
+
+  // Without a chip, begin() fails but objects can still be exercised
+  qt.begin(IS3741_ADDR_DEFAULT, i2c);
+  qtDirect.begin(IS3741_ADDR_DEFAULT, i2c);
+  glasses.begin(IS3741_ADDR_DEFAULT, i2c);
+  i2c->setClock(400000);
+  qt.setRotoZoom(&xform, 10000, IS3741_FIXED(1.2), IS3741_FIXED(4),
+                 IS3741_FIXED(4), IS3741_FIXED(6.5), IS3741_FIXED(4.5));
+
+  uint16_t failures = 0, unchecked = 0;
+  Serial.println("workload,ns_per_op,bus_bytes,transactions,bus_us,"
+                 "static_ram_bytes,result");
+  for (uint8_t w = 0; w < NUM_WORKLOADS; w++) {
+    Workload *wl = &workloads[w];
+    if ((wl->run == runScaleSmooth || wl->run == runScalePoint) &&
+        !glasses.getCanvas()) {
+      measuredNs[w] = 0;
+      Serial.print(wl->name);
+      Serial.println(",,,,,,SKIP"); // Not enough RAM for canvas
+      continue;
+    }
+
+    // One traced run for bus figures (tracing would skew timing)...
+    model.reset();
+    qt.setTrace(&model);
+    qtDirect.setTrace(&model);
+    glasses.setTrace(&model);
+    wl->run();
+    qt.setTrace(NULL);
+    qtDirect.setTrace(NULL);
+    glasses.setTrace(NULL);
+
+    // ...then untraced runs for timing
+    uint32_t t = micros();
+    for (uint8_t i = 0; i < ITERATIONS; i++) wl->run();
+    t = micros() - t;
+    uint32_t ns = t * (1000 / ITERATIONS) + // Split to avoid overflow
+                  (t * (1000 % ITERATIONS)) / ITERATIONS;
+    measuredNs[w] = ns;
+
+    bool pass = (model.bytes() <= wl->baseBytes) &&
+                (model.transactions() <= wl->baseTx);
+    if (wl->baseNs && (ns > wl->baseNs + wl->baseNs / 100 * TIME_TOLERANCE))
+      pass = false;
+    if (!pass) failures++;
+    else if (!wl->baseNs) unchecked++;
+
+    Serial.print(wl->name);
+    Serial.print(',');
+    Serial.print(ns);
+    Serial.print(',');
+    Serial.print(model.bytes());
+    Serial.print(',');
+    Serial.print(model.transactions());
+    Serial.print(',');
+    Serial.print(model.busMicros());
+    Serial.print(',');
+    Serial.print(wl->ram);
+    if (!pass) Serial.println(",FAIL");
+    else if (!wl->baseNs) Serial.println(",NO_BASELINE");
+    else Serial.println(",PASS");
+  }
+
+  Serial.print("RESULT,");
+  if (failures) Serial.println("FAIL");
+  else if (unchecked) Serial.println("NO_BASELINE");
+  else Serial.println("PASS");
+
+  // Times measured here, in table order, for updating baselines
+  Serial.print("# Measured ns:");
+  for (uint8_t w = 0; w < NUM_WORKLOADS; w++) {
+    Serial.print(' ');
+    Serial.print(measuredNs[w]);
+  }
+  Serial.println();
+}
+
+void loop() {
+}
@@ -0,0 +1,178 @@
+// Memory footprint report for the IS31FL3741 library, to help choose
+// between direct, buffered and canvas variants and to measure the effect
+// of memory-saving changes over time. Prints CSV lines over Serial:
+//   class,<name>,<object bytes>,<heap bytes at construction>,<at begin()>
+//   table,<name>,<PROGMEM bytes>
+//   stack,<operation>,<peak stack bytes>
+// Heap figures are measured where the platform makes it possible (AVR,
+// ARM, ESP), else printed as -1. Peak stack is found by "painting" a
+// region below the current stack pointer with a known value, running the
+// operation, and counting how much of the paint got overwritten.
+// No IS31FL3741 needs to be connected; begin() allocates the same either
+// way, but with a chip present show() figures include real transfers.
+
+#include <Adafruit_IS31FL3741.h>
+
+// Some boards have just one I2C interface, but some have more...
+TwoWire *i2c = &Wire; // e.g. change this to &Wire1 for QT Py RP2040
+
+#if defined(__AVR__)
+#define STACK_PROBE 256 // Bytes of stack painted, must exceed peak use
+#else
+#define STACK_PROBE 2048
+#endif
+
+#if defined(__AVR__)
+extern int __heap_start, *__brkval;
+#elif defined(__arm__)
+extern "C" char *sbrk(int incr);
+#endif
+
+// Free RAM between heap and stack (or free heap on ESP), -1 if unknown.
+// Only differences between calls from the same function are meaningful.
+int32_t freeHeap(void) {
+#if defined(__AVR__)
+  int top;
+  return (int)&top - (__brkval ? (int)__brkval : (int)&__heap_start);
+#elif defined(__arm__)
+  char top;
+  return &top - sbrk(0);
+#elif defined(ESP8266) || defined(ESP32)
+  return ESP.getFreeHeap();
+#else
+  return -1;
+#endif
+}
+
+uintptr_t paint; // Address of painted stack (lowest byte)
+
+// Fill STACK_PROBE bytes below the caller's stack frame with a pattern...
+void __attribute__((noinline)) paintStack(void) {
+  volatile uint8_t pad[STACK_PROBE];
+  for (uint16_t i = 0; i < STACK_PROBE; i++)
+    pad[i] = 0xA5;
+  paint = (uintptr_t)pad;
+}
+
+// ...and after running something, count how much of it was overwritten.
+// Stack grows down, so untouched paint remains at the low end.
+uint16_t probeStack(void) {
+  volatile uint8_t *ptr = (volatile uint8_t *)paint;
+  uint16_t i = 0;
+  while ((i < STACK_PROBE) && (ptr[i] == 0xA5))
+    i++;
+  return STACK_PROBE - i;
+}
+
+void printClass(const char *name, size_t bytes, int32_t ctorHeap = 0,
+                int32_t beginHeap = 0, bool known = true) {
+  Serial.print("class,");
+  Serial.print(name);
+  Serial.print(',');
+  Serial.print(bytes);
+  Serial.print(',');
+  Serial.print(known ? ctorHeap : -1);
+  Serial.print(',');
+  Serial.println(known ? beginHeap : -1);
+}
+
+void printPair(const char *kind, const char *name, uint32_t bytes) {
+  Serial.print(kind);
+  Serial.print(',');
+  Serial.print(name);
+  Serial.print(',');
+  Serial.println(bytes);
+}
+
+// Construct an object on the stack, then begin() it, noting heap use of
+// each step. Objects are never deleted by the library, so any heap taken
+// by begin() (the I2C device) is leaked each time, as it would be in use.
+#define HEAP_REPORT(type, ctorArgs, beginArgs)                                \
+  {                                                                           \
+    int32_t h0 = freeHeap();                                                  \
+    type obj ctorArgs;                                                        \
+    int32_t h1 = freeHeap();                                                  \
+    obj.begin beginArgs;                                                      \
+    int32_t h2 = freeHeap();                                                  \
+    printClass(#type #ctorArgs, sizeof obj, h0 - h1, h1 - h2, h0 >= 0);       \
+  }
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) delay(10); // Wait for Serial Monitor on native USB boards
+
+  // Controller and matrix classes, measured with construction and begin()
+  HEAP_REPORT(Adafruit_IS31FL3741, , (IS3741_ADDR_DEFAULT, i2c));
+  HEAP_REPORT(Adafruit_IS31FL3741_buffered, , (IS3741_ADDR_DEFAULT, i2c));
+  HEAP_REPORT(Adafruit_IS31FL3741_QT, , (IS3741_ADDR_DEFAULT, i2c));
+  HEAP_REPORT(Adafruit_IS31FL3741_QT_buffered, , (IS3741_ADDR_DEFAULT, i2c));
+  HEAP_REPORT(Adafruit_IS31FL3741_EVB, , (IS3741_ADDR_DEFAULT, i2c));
+  HEAP_REPORT(Adafruit_IS31FL3741_EVB_buffered, , (IS3741_ADDR_DEFAULT, i2c));
+  HEAP_REPORT(Adafruit_EyeLights, (false), (IS3741_ADDR_DEFAULT, i2c));
+  HEAP_REPORT(Adafruit_EyeLights, (true), (IS3741_ADDR_DEFAULT, i2c));
+  HEAP_REPORT(Adafruit_EyeLights_buffered, (false),
+              (IS3741_ADDR_DEFAULT, i2c));
+  HEAP_REPORT(Adafruit_EyeLights_buffered, (true), (IS3741_ADDR_DEFAULT, i2c));
+
+  // Helper classes allocate nothing; object size is the whole story
+  printClass("Adafruit_EyeLights_Ring", sizeof(Adafruit_EyeLights_Ring));
+  printClass("Adafruit_EyeLights_Ring_buffered",
+             sizeof(Adafruit_EyeLights_Ring_buffered));
+  printClass("Adafruit_IS31FL3741_Effects",
+             sizeof(Adafruit_IS31FL3741_Effects));
+  printClass("Adafruit_IS31FL3741_ParticlePool<16>",
+             sizeof(Adafruit_IS31FL3741_ParticlePool<16>));
+  printClass("Adafruit_IS31FL3741_Spectrum",
+             sizeof(Adafruit_IS31FL3741_Spectrum));
+  printClass("Adafruit_IS31FL3741_TripleBuffer",
+             sizeof(Adafruit_IS31FL3741_TripleBuffer));
+  printClass("Adafruit_IS31FL3741_FramePacer",
+             sizeof(Adafruit_IS31FL3741_FramePacer));
+  printClass("Adafruit_IS31FL3741_TraceBuffer",
+             sizeof(Adafruit_IS31FL3741_TraceBuffer));
+  printClass("Adafruit_IS31FL3741_Model", sizeof(Adafruit_IS31FL3741_Model),
+             0, 0);
+  printClass("Adafruit_IS31FL3741_BusModel",
+             sizeof(Adafruit_IS31FL3741_BusModel));
+
+  // PROGMEM tables. Most are private to the library source; these sizes
+  // follow their declarations there and need updating if those change.
+  printPair("table", "_IS31GammaTable", sizeof _IS31GammaTable);
+  printPair("table", "_IS31SineTable", 65 * 2);
+  printPair("table", "glassesmatrix_ledmap", 18 * 5 * 3 * 2);
+  printPair("table", "left_ring_map", 24 * 3 * 2);
+  printPair("table", "right_ring_map", 24 * 3 * 2);
+  printPair("table", "gammaRB", 31 * 9 + 1);
+  printPair("table", "gammaG", 63 * 9 + 1);
+  printPair("table", "_IS31NoisePerm", 256);
+  printPair("table", "_IS31NoiseGrad", 12 * 3);
+
+  // Peak stack of the busiest calls. Objects live in their own blocks so
+  // only one large buffer is on the stack at a time.
+  {
+    Adafruit_IS31FL3741_QT_buffered qt;
+    qt.begin(IS3741_ADDR_DEFAULT, i2c);
+    paintStack();
+    qt.show();
+    printPair("stack", "show", probeStack());
+    qt.setISRSafe(true);
+    paintStack();
+    qt.show();
+    printPair("stack", "show_isrsafe", probeStack());
+  }
+  {
+    Adafruit_EyeLights_buffered glasses(true);
+    glasses.begin(IS3741_ADDR_DEFAULT, i2c);
+    if (glasses.getCanvas()) {
+      paintStack();
+      glasses.scale();
+      printPair("stack", "scale", probeStack());
+    } else {
+      Serial.println("stack,scale,-1"); // Canvas didn't fit in RAM
+    }
+  }
+  Serial.println("done");
+}
+
+void loop() {
+}
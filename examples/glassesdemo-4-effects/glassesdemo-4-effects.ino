@@ -0,0 +1,99 @@
+// Procedural effects example for Adafruit LED glasses. Cycles through the
+// plasma, noise, fire and twinkle animations of Adafruit_IS31FL3741_Effects,
+// which write straight into the buffered matrix using only integer math.
+// At startup, each effect is also timed on both the 18x5 glasses and 13x9
+// STEMMA QT matrix geometries (no QT matrix needs to be connected for that,
+// it's just math) and results are printed to the Serial Monitor, so you
+// can see how much of each frame is left over for your own code.
+
+#include <Adafruit_IS31FL3741.h>
+
+// Some boards have just one I2C interface, but some have more...
+TwoWire *i2c = &Wire; // e.g. change this to &Wire1 for QT Py RP2040
+
+Adafruit_EyeLights_buffered glasses;
+Adafruit_IS31FL3741_Effects effects(&glasses);
+
+#define SECONDS_PER_EFFECT 8
+uint8_t effect = 0;          // Current effect, 0-3
+uint32_t effect_start = 0;   // millis() when current effect started
+uint16_t twinkle_hue = 0;    // Twinkle color changes with each cycle
+
+// Run one frame of effect 'e' on an Effects object
+void runEffect(Adafruit_IS31FL3741_Effects &fx, uint8_t e) {
+  switch (e) {
+  case 0:
+    fx.plasma();
+    break;
+  case 1:
+    fx.noise(3, 64, 40000); // Bluish base hue
+    break;
+  case 2:
+    fx.fire();
+    break;
+  default:
+    fx.twinkle(glasses.ColorHSV(twinkle_hue, 100));
+    break;
+  }
+}
+
+// Print average time in microseconds for each effect on a matrix
+void benchmark(Adafruit_IS31FL3741_colorGFX_buffered *matrix,
+               const char *name) {
+  static const char *names[] = {"plasma", "noise", "fire", "twinkle"};
+  Adafruit_IS31FL3741_Effects fx(matrix);
+  for (uint8_t e = 0; e < 4; e++) {
+    uint32_t t = micros();
+    for (uint8_t i = 0; i < 20; i++) runEffect(fx, e);
+    t = (micros() - t) / 20;
+    Serial.print(name);
+    Serial.print(' ');
+    Serial.print(names[e]);
+    Serial.print(": ");
+    Serial.print(t);
+    Serial.println(" us/frame (excluding show())");
+  }
+}
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("ISSI3741 LED Glasses Effects Test");
+
+  // Timing doesn't need any hardware, do it before begin()
+  benchmark(&glasses, "EyeLights 18x5");
+  Adafruit_IS31FL3741_QT_buffered *qt = new Adafruit_IS31FL3741_QT_buffered;
+  if (qt) {
+    benchmark(qt, "QT matrix 13x9");
+    delete qt;
+  }
+
+  if (! glasses.begin(IS3741_ADDR_DEFAULT, i2c)) {
+    Serial.println("IS41 not found");
+    for (;;);
+  }
+
+  Serial.println("IS41 found!");
+
+  // By default the LED controller communicates over I2C at 400 KHz.
+  // Arduino Uno can usually do 800 KHz, and 32-bit microcontrollers 1 MHz.
+  i2c->setClock(800000);
+
+  // Set brightness to max and bring controller out of shutdown state
+  glasses.setLEDscaling(0xFF);
+  glasses.setGlobalCurrent(0xFF);
+  glasses.enable(true);
+
+  // Start with all LEDs off (effects only cover the matrix, not rings)
+  glasses.fill(0);
+  effect_start = millis();
+}
+
+void loop() {
+  if ((millis() - effect_start) > (SECONDS_PER_EFFECT * 1000UL)) {
+    effect = (effect + 1) % 4; // Next effect
+    twinkle_hue += 65536 / 5;
+    effect_start = millis();
+  }
+  runEffect(effects, effect);
+  glasses.show(); // Buffered glasses MUST use show() to update!
+}
@@ -0,0 +1,78 @@
+// Particle system example for Adafruit LED glasses: a fountain of sparks
+// on the matrix, and a comet chasing around each ring. Particles are added
+// (not overwritten) into the LED buffer, so where they overlap they glow
+// brighter, and with fractional positions they move smoothly even on such
+// a coarse display.
+
+#include <Adafruit_IS31FL3741.h>
+
+// Some boards have just one I2C interface, but some have more...
+TwoWire *i2c = &Wire; // e.g. change this to &Wire1 for QT Py RP2040
+
+Adafruit_EyeLights_buffered glasses;
+
+// Particle pools hold a fixed number of particles, 14 bytes RAM each,
+// so boards with little RAM (e.g. Uno) get fewer sparks.
+#if defined(__AVR__)
+Adafruit_IS31FL3741_ParticlePool<40> sparks(&glasses);
+#else
+Adafruit_IS31FL3741_ParticlePool<100> sparks(&glasses);
+#endif
+Adafruit_IS31FL3741_ParticlePool<20> comets(&glasses);
+
+// Sparks go from white-hot to yellow to red, then fade out
+const uint32_t spark_colors[] = {0xFFFFFF, 0xFFFF00, 0xFF0000, 0x000000};
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("ISSI3741 LED Glasses Particles Test");
+
+  if (! glasses.begin(IS3741_ADDR_DEFAULT, i2c)) {
+    Serial.println("IS41 not found");
+    for (;;);
+  }
+
+  Serial.println("IS41 found!");
+
+  // By default the LED controller communicates over I2C at 400 KHz.
+  // Arduino Uno can usually do 800 KHz, and 32-bit microcontrollers 1 MHz.
+  i2c->setClock(800000);
+
+  // Set brightness to max and bring controller out of shutdown state
+  glasses.setLEDscaling(0xFF);
+  glasses.setGlobalCurrent(0xFF);
+  glasses.enable(true);
+
+  glasses.right_ring.setBrightness(50);  // Turn down the LED rings brightness,
+  glasses.left_ring.setBrightness(50);   // 0 = off, 255 = max
+
+  sparks.setColorRamp(spark_colors, 4);
+  sparks.setGravity(0, 6); // Positions are 1/256 pixel units, so this is
+  sparks.setDrag(4);       // a gentle pull downward, and a little drag.
+}
+
+uint16_t comet_hue = 0;
+
+void loop() {
+  // Launch a few sparks per frame from bottom center, fanning upward.
+  // Positions & velocities are in 1/256 pixel units.
+  for (uint8_t i = 0; i < 3; i++) {
+    sparks.spawn(9 * 256, 5 * 256, random(-80, 81), random(-220, -120),
+                 random(20, 50));
+  }
+  // Comets are a head particle leaving a trail of short-lived ones, hue
+  // slowly cycling. X position is the ring pixel (0-23) times 256.
+  static int16_t comet_x = 0;
+  comet_x = (comet_x + 60) % (24 * 256);
+  comets.spawn(comet_x, 0, 0, 0, 16, comet_hue += 64);
+
+  sparks.update();
+  comets.update(false); // false = wrap around ring, don't cull off-matrix
+
+  glasses.fill(0);
+  sparks.render();
+  glasses.bloom(160, 64); // Soft glow around the hottest sparks
+  comets.render(&glasses.left_ring);
+  comets.render(&glasses.right_ring);
+  glasses.show(); // Buffered glasses MUST use show() to update!
+}
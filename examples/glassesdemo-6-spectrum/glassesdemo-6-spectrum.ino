@@ -0,0 +1,77 @@
+// Audio spectrum example for Adafruit LED glasses. Bars on the matrix and
+// colors around the rings follow the loudness of different frequencies.
+// To keep this example self-contained it makes up its own "music" (a few
+// sweeping tones), see getSamples() below for where to plug in a real
+// microphone, e.g. the PDM mic on a Feather nRF52840 Sense. The time to
+// process and draw each block is printed to the Serial Monitor.
+
+#include <Adafruit_IS31FL3741.h>
+
+// Some boards have just one I2C interface, but some have more...
+TwoWire *i2c = &Wire; // e.g. change this to &Wire1 for QT Py RP2040
+
+Adafruit_EyeLights_buffered glasses;
+Adafruit_IS31FL3741_Spectrum spectrum(&glasses);
+
+int16_t samples[IS3741_SPECTRUM_SAMPLES];
+
+// Fill samples[] with the next block of audio. Replace this with reads
+// from a microphone or other source; any sample rate works, it just
+// changes which frequencies land on which bars.
+void getSamples() {
+  static uint16_t phase1 = 0, phase2 = 0, sweep = 0;
+  sweep += 40;
+  // Tone 1 slides up & down, tone 2 steady but pulsing
+  uint16_t step1 = 1200 + (glasses.sin16(sweep) + 32768) / 3;
+  int16_t level2 = glasses.sin16(sweep * 7) / 2;
+  for (uint16_t i = 0; i < IS3741_SPECTRUM_SAMPLES; i++) {
+    samples[i] = (glasses.sin16(phase1 += step1) >> 1) +
+                 ((int32_t)glasses.sin16(phase2 += 9000) * level2 >> 16);
+  }
+}
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("ISSI3741 LED Glasses Spectrum Test");
+
+  if (! glasses.begin(IS3741_ADDR_DEFAULT, i2c)) {
+    Serial.println("IS41 not found");
+    for (;;);
+  }
+
+  Serial.println("IS41 found!");
+
+  // By default the LED controller communicates over I2C at 400 KHz.
+  // Arduino Uno can usually do 800 KHz, and 32-bit microcontrollers 1 MHz.
+  i2c->setClock(800000);
+
+  // Set brightness to max and bring controller out of shutdown state
+  glasses.setLEDscaling(0xFF);
+  glasses.setGlobalCurrent(0xFF);
+  glasses.enable(true);
+
+  glasses.right_ring.setBrightness(50);  // Turn down the LED rings brightness,
+  glasses.left_ring.setBrightness(50);   // 0 = off, 255 = max
+}
+
+uint32_t total_time = 0;
+uint16_t blocks = 0;
+
+void loop() {
+  getSamples();
+
+  uint32_t t = micros();
+  spectrum.process(samples);             // FFT & band levels
+  spectrum.render();                     // Bars on matrix
+  spectrum.render(&glasses.left_ring);   // And rings
+  spectrum.render(&glasses.right_ring);
+  total_time += micros() - t;
+
+  glasses.show(); // Buffered glasses MUST use show() to update!
+
+  if (++blocks >= 100) {
+    Serial.print(total_time / blocks);
+    Serial.println(" us per block (process + render, excluding show())");
+    total_time = blocks = 0;
+  }
+}
@@ -0,0 +1,118 @@
+// Adaptive quality example for Adafruit LED glasses. Builds on the smooth
+// scrolling text of the third example, but runs at a fixed frame rate with
+// a FramePacer object. If a frame takes too long to draw and send (e.g. on
+// a slow microcontroller or I2C bus), the pacer steps down quality level
+// and the sketch drops costly features in stages: cheaper scaling, then
+// fewer in-between text positions, then less frequent ring updates. Once
+// there's time to spare, it steps back up. Try a slower setClock() value
+// below to see it in action. Like the third example, this needs an extra
+// 1.5K RAM and probably won't work on small boards like Arduino Uno.
+
+#include <Adafruit_IS31FL3741.h>
+#include <EyeLightsCanvasFont.h>
+
+// Some boards have just one I2C interface, but some have more...
+TwoWire *i2c = &Wire; // e.g. change this to &Wire1 for QT Py RP2040
+
+Adafruit_EyeLights_buffered glasses(true); // Buffered, with 3X canvas
+Adafruit_IS31FL3741_FramePacer pacer(&glasses, 60); // 60 frames/sec
+
+char text[] = "ADAFRUIT!"; // A message to scroll
+int text_x;                // Pos is initialized in setup()
+int text_min;              // Pos. where text resets (calc'd later)
+int text_y = 15;           // Text base line at bottom of canvas
+uint16_t ring_hue = 0;     // For ring animation
+uint8_t quality;           // Last quality level, for printing changes
+
+GFXcanvas16 *canvas;       // Pointer to canvas object
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("ISSI3741 LED Glasses Adaptive Quality Test");
+
+  if (! glasses.begin(IS3741_ADDR_DEFAULT, i2c)) {
+    Serial.println("IS41 not found");
+    for (;;);
+  }
+
+  canvas = glasses.getCanvas();
+  if (! canvas) {
+    Serial.println("Couldn't allocate canvas");
+    for (;;);
+  }
+
+  Serial.println("IS41 found!");
+
+  // 32-bit microcontrollers can usually do 1 MHz I2C. Try 400000 (the
+  // default) or even 100000 to see quality levels drop.
+  i2c->setClock(1000000);
+
+  // Set brightness to max and bring controller out of shutdown state
+  glasses.setLEDscaling(0xFF);
+  glasses.setGlobalCurrent(0xFF);
+  glasses.enable(true);
+
+  text_x = canvas->width(); // Initial text position = off right edge
+  canvas->setFont(&EyeLightsCanvasFont);
+  canvas->setTextWrap(false); // Allow text to extend off edges
+  glasses.right_ring.setBrightness(50);
+  glasses.left_ring.setBrightness(50);
+
+  // Get text dimensions to determine X coord where scrolling resets
+  uint16_t w, h;
+  int16_t ignore;
+  canvas->getTextBounds(text, 0, 0, &ignore, &ignore, &w, &h);
+  text_min = -w; // Off left edge this many pixels
+
+  pacer.setAdaptive(true); // Let pacer adjust quality level
+  quality = pacer.getQuality();
+}
+
+void loop() {
+  // Text moves one canvas pixel (1/3 LED) per frame. Positions in between
+  // whole LEDs are the "interpolated" frames; when those aren't allowed,
+  // the matrix is only redrawn when text lines up with the LEDs.
+  if (pacer.allowInterpolatedFrame() || !(text_x % 3)) {
+    canvas->fillScreen(0);
+    canvas->setCursor(text_x, text_y);
+    for (int i = 0; i < (int)strlen(text); i++) {
+      uint32_t color888 = glasses.ColorHSV(65536 * i / strlen(text));
+      canvas->setTextColor(glasses.color565(color888));
+      canvas->print(text[i]);
+    }
+    // Smooth 3x3 scaling at full quality, center pixel otherwise
+    glasses.scale(pacer.allowSmoothScale());
+  }
+  if (--text_x < text_min) {  // If text scrolls off left edge,
+    text_x = canvas->width(); // reset position off right edge
+  }
+
+  // Rings are redrawn every frame at high quality levels, less often
+  // at the lowest ones. Hue changes every frame regardless, so they
+  // spin at the same speed either way.
+  if (pacer.allowRingUpdate()) {
+    for (int i=0; i < glasses.left_ring.numPixels(); i++) {
+      glasses.left_ring.setPixelColor(i, glasses.ColorHSV(
+        ring_hue + i * 65536 / glasses.left_ring.numPixels()));
+    }
+    for (int i=0; i < glasses.right_ring.numPixels(); i++) {
+      glasses.right_ring.setPixelColor(i, glasses.ColorHSV(
+        ring_hue - i * 65536 / glasses.right_ring.numPixels()));
+    }
+  }
+  ring_hue += 1000;
+
+  pacer.show(); // Replaces glasses.show() and delay()
+
+  if (pacer.getQuality() != quality) {
+    quality = pacer.getQuality();
+    const IS3741_frameStats *stats = pacer.getStats();
+    Serial.print("Quality level ");
+    Serial.print(quality);
+    Serial.print(" (draw ");
+    Serial.print(stats->renderAvg);
+    Serial.print(" us, show ");
+    Serial.print(stats->showAvg);
+    Serial.println(" us)");
+  }
+}
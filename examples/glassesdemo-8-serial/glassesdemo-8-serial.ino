@@ -0,0 +1,49 @@
+// Serial streaming example for Adafruit LED glasses. Frames are sent from
+// a computer over USB serial using the binary format documented with
+// Adafruit_IS31FL3741_FrameReceiver in the library header: full frames,
+// runs of changed LEDs, or 4-bit palette images. The receiver writes them
+// straight into the LED buffer and calls show(). With acknowledgement on,
+// the board replies 'K' (good) or 'E' (bad checksum) after each message,
+// so the sender can wait for a reply before sending the next frame.
+// A minimal sender in Python (pyserial), for a full frame of 351 values:
+//   def fletcher(data):
+//       s1 = s2 = 0
+//       for b in data:
+//           s1 = (s1 + b) % 255
+//           s2 = (s2 + s1) % 255
+//       return bytes([s1, s2])
+//   def send(port, type, payload):
+//       body = bytes([ord(type)]) + len(payload).to_bytes(2, 'little')
+//       body += bytes(payload)
+//       port.write(b'IS' + body + fletcher(body))
+//       return port.read(1) # b'K' or b'E'
+//   send(serial.Serial('/dev/ttyACM0'), 'F', [frame values...])
+
+#include <Adafruit_IS31FL3741.h>
+
+// Some boards have just one I2C interface, but some have more...
+TwoWire *i2c = &Wire; // e.g. change this to &Wire1 for QT Py RP2040
+
+Adafruit_EyeLights_buffered glasses;
+Adafruit_IS31FL3741_FrameReceiver receiver(&glasses, &Serial);
+
+void setup() {
+  Serial.begin(115200); // Native USB boards ignore the rate
+
+  if (! glasses.begin(IS3741_ADDR_DEFAULT, i2c)) {
+    while (1);
+  }
+
+  // Fast I2C keeps show() short, so serial input doesn't back up
+  i2c->setClock(1000000);
+
+  glasses.setLEDscaling(0xFF);
+  glasses.setGlobalCurrent(0xFF);
+  glasses.enable(true);
+
+  receiver.setAck(true); // Nothing else may print to Serial then!
+}
+
+void loop() {
+  receiver.poll();
+}
@@ -0,0 +1,95 @@
+// Bytecode program example for Adafruit LED glasses. The animation here
+// isn't compiled C++ but a small program for the library's bytecode
+// interpreter (Adafruit_IS31FL3741_VM), stored in flash. A different
+// program can be sent over serial while this runs (e.g. from a file on a
+// computer) and takes over immediately, no reflashing needed. Programs
+// are byte arrays built with the IS3741_OP_* opcodes and IS3741_PUSH()
+// and similar macros; see the library header for the instruction set.
+// Once a second, frames/sec and instructions/frame are printed, to check
+// a program's cost against the frame rate you're after.
+
+#include <Adafruit_IS31FL3741.h>
+
+// Some boards have just one I2C interface, but some have more...
+TwoWire *i2c = &Wire; // e.g. change this to &Wire1 for QT Py RP2040
+
+Adafruit_EyeLights_buffered glasses;
+Adafruit_IS31FL3741_VM vm(&glasses);
+
+// Scrolling rainbow on the matrix, with one lit pixel chasing around
+// each ring. Variable 0 is the rainbow's starting hue.
+const uint8_t PROGMEM rainbow[] = {
+    IS3741_PUSH(18), IS3741_OP_REPEAT,          // For each column x...
+    IS3741_OP_INDEX, IS3741_PUSH(0),            // x, y=0
+    IS3741_PUSH(1), IS3741_PUSH(5),             // w=1, h=5
+    IS3741_OP_INDEX, IS3741_PUSH(3640),         // Hue = x * 3640
+    IS3741_OP_MUL, IS3741_LOAD(0), IS3741_OP_ADD, //   + starting hue
+    IS3741_PUSH(255), IS3741_PUSH(64),          // Saturation, value
+    IS3741_OP_HSV, IS3741_OP_RECT,              // Fill column w/color
+    IS3741_OP_NEXT,                             // ...next column
+    IS3741_LOAD(0), IS3741_PUSH(500),           // Advance starting hue
+    IS3741_OP_ADD, IS3741_STORE(0),
+    IS3741_PUSH(0), IS3741_COLOR(0), IS3741_OP_RINGFILL, // Clear rings
+    IS3741_PUSH(1), IS3741_COLOR(0), IS3741_OP_RINGFILL,
+    IS3741_PUSH(0), IS3741_OP_FRAME, IS3741_PUSH(24), // Left ring pixel
+    IS3741_OP_MOD, IS3741_COLOR(0x404040), IS3741_OP_RING, // frame % 24
+    IS3741_PUSH(1), IS3741_PUSH(23), IS3741_OP_FRAME, // Right ring pixel
+    IS3741_PUSH(24), IS3741_OP_MOD, IS3741_OP_SUB,    // 23 - frame % 24
+    IS3741_COLOR(0x404040), IS3741_OP_RING,
+    IS3741_OP_SHOW, IS3741_PUSH(20), IS3741_OP_WAIT, // Show, pause 20 ms
+};
+
+uint8_t uploaded[256]; // RAM for program received over serial
+uint32_t lastReport = 0, lastFrames = 0, lastInstructions = 0;
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("EyeLights bytecode test");
+
+  if (! glasses.begin(IS3741_ADDR_DEFAULT, i2c)) {
+    Serial.println("Not found");
+    while (1);
+  }
+
+  i2c->setClock(800000);
+  glasses.setLEDscaling(0xFF);
+  glasses.setGlobalCurrent(0xFF);
+  glasses.enable(true);
+
+  vm.setRings(&glasses.left_ring, &glasses.right_ring);
+  vm.load(rainbow, sizeof rainbow, true); // true = program in PROGMEM
+  Serial.setTimeout(100); // Upload ends after 100 ms without data
+}
+
+void loop() {
+  if (Serial.available()) { // New program arriving
+    uint16_t len = vm.load(&Serial, uploaded, sizeof uploaded);
+    Serial.print("Loaded ");
+    Serial.print(len);
+    Serial.println(" byte program");
+    lastFrames = lastInstructions = 0;
+  }
+
+  static uint32_t frames = 0;
+  IS3741_vmStatus status = vm.run();
+  if (status == IS3741_VM_FRAME) {
+    frames++;
+  } else if (status == IS3741_VM_ERROR) {
+    Serial.print("Program error at byte ");
+    Serial.println(vm.pc());
+    vm.load(rainbow, sizeof rainbow, true); // Back to built-in program
+  }
+
+  uint32_t now = millis();
+  if ((now - lastReport) >= 1000) {
+    lastReport = now;
+    uint32_t f = frames - lastFrames;
+    uint32_t i = vm.instructions() - lastInstructions;
+    Serial.print(f);
+    Serial.print(" frames/sec, ");
+    Serial.print(f ? (i / f) : i);
+    Serial.println(" instructions/frame");
+    lastFrames = frames;
+    lastInstructions = vm.instructions();
+  }
+}
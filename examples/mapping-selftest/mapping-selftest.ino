@@ -0,0 +1,221 @@
+// Pixel mapping self-test for the IS31FL3741 library. Each board type maps
+// X/Y pixels to LED driver registers differently (evaluation board, STEMMA
+// QT matrix, EyeLights glasses and their LED rings), and that code is easy
+// to break when optimizing. This draws a standard pattern -- a different
+// color in every pixel, plus a border just off the edges that must NOT
+// show up -- in all four rotations and all six RGB color orders for each
+// buffered class, and compares a CRC-16 of the resulting LED buffer
+// against "golden" values recorded from known-good code. No hardware is
+// needed for that part, so it'll run on any board with a Serial Monitor.
+// If an IS31FL3741 IS connected (any board type, nothing is displayed),
+// the direct (unbuffered) classes are also checked: their I2C writes go
+// to an Adafruit_IS31FL3741_Model trace sink, whose registers must match
+// the same golden values, so direct and buffered drawing must agree.
+// If a mapping is changed ON PURPOSE, the printed CRCs become the new
+// golden values.
+
+#include <Adafruit_IS31FL3741.h>
+
+// Some boards have just one I2C interface, but some have more...
+TwoWire *i2c = &Wire; // e.g. change this to &Wire1 for QT Py RP2040
+
+const IS3741_order orders[] = { IS3741_RGB, IS3741_RBG, IS3741_GRB,
+                                IS3741_GBR, IS3741_BRG, IS3741_BGR };
+const char *orderNames[] = { "RGB", "RBG", "GRB", "GBR", "BRG", "BGR" };
+const char *boardNames[] = { "EVB", "QT", "EyeLights" };
+
+// Golden CRCs of matrix pattern, [board][rotation][color order]
+const uint16_t PROGMEM goldenMatrix[3][4][6] = {
+  { // EVB
+    { 0x6EB7, 0xAF01, 0xE396, 0x23BD, 0x5D4D, 0x5CD0 },
+    { 0x0BF9, 0xA9AE, 0x3FAE, 0x21AB, 0x5F51, 0xE303 },
+    { 0x9D0C, 0x50DA, 0xB3F3, 0x60F8, 0xA0C4, 0xBE19 },
+    { 0xC8F0, 0x6F1F, 0x1F47, 0xEA05, 0x92A5, 0xC008 } },
+  { // QT
+    { 0x5DED, 0x902F, 0x9A9E, 0x8FC3, 0x14F1, 0xCC6E },
+    { 0xF531, 0x9685, 0xCE95, 0x02EE, 0xAB90, 0x045F },
+    { 0x5AF8, 0x6386, 0xE303, 0x676C, 0x14DA, 0xA9CB },
+    { 0x8CFA, 0xF679, 0x0469, 0xC60D, 0x9364, 0x2B83 } },
+  { // EyeLights
+    { 0xC689, 0xFCE6, 0xFF83, 0xE73E, 0xBECE, 0x9C1C },
+    { 0xFCA7, 0x6CF2, 0x8BBC, 0x5D7E, 0x6209, 0x249E },
+    { 0xF517, 0x7100, 0x2114, 0x9F36, 0x0603, 0x3C36 },
+    { 0x662A, 0x03B9, 0xD268, 0x40E8, 0x9714, 0x6007 } },
+};
+
+// Golden CRCs of EyeLights rings pattern, [color order]
+const uint16_t PROGMEM goldenRings[6] = {
+  0x4ACC, 0x7963, 0x3F7A, 0x1535, 0x8D97, 0x9477 };
+
+uint16_t failures = 0;
+
+// CRC-16/CCITT-FALSE of a block of bytes
+uint16_t crc16(const uint8_t *data, uint16_t len) {
+  uint16_t crc = 0xFFFF;
+  while (len--) {
+    crc ^= (uint16_t)*data++ << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+    }
+  }
+  return crc;
+}
+
+// A different RGB565 color for every pixel, with red, green and blue all
+// varying so that color order mistakes change the result.
+uint16_t patternColor(int16_t x, int16_t y) {
+  return (uint16_t)((x + 1) * 2749 + (y + 1) * 7919) * 40503;
+}
+
+// Draw pattern in given rotation, including a border 1 pixel beyond
+// every edge, which should be clipped.
+void drawPattern(Adafruit_GFX *gfx, uint8_t rotation) {
+  gfx->setRotation(rotation);
+  for (int16_t y = -1; y <= gfx->height(); y++) {
+    for (int16_t x = -1; x <= gfx->width(); x++) {
+      gfx->drawPixel(x, y, patternColor(x, y));
+    }
+  }
+}
+
+// A different color for every pixel of both rings (0 = left, 1 = right).
+// 16-bit pattern colors are expanded to 24-bit so all bits of each
+// channel are tested.
+uint32_t ringColor(int16_t i, uint8_t ring) {
+  uint16_t c = patternColor(i, ring);
+  return ((uint32_t)c << 8) | ((c >> 4) & 0xFF);
+}
+
+bool check(const char *what, uint8_t board, uint8_t rotation,
+           uint8_t order, uint16_t crc, uint16_t golden) {
+  if (crc == golden) return true;
+  failures++;
+  Serial.print("FAIL ");
+  Serial.print(what);
+  Serial.print(' ');
+  Serial.print(boardNames[board]);
+  Serial.print(" rotation ");
+  Serial.print(rotation);
+  Serial.print(' ');
+  Serial.print(orderNames[order]);
+  Serial.print(": CRC 0x");
+  Serial.print(crc, HEX);
+  Serial.print(", expected 0x");
+  Serial.println(golden, HEX);
+  return false;
+}
+
+// Draw pattern on a buffered object, return CRC of its LED buffer
+uint16_t bufferedCRC(Adafruit_GFX *gfx, Adafruit_IS31FL3741_buffered *buf,
+                     uint8_t rotation) {
+  memset(buf->getBuffer(), 0, 351); // Not cleared if begin() not called
+  drawPattern(gfx, rotation);
+  return crc16(buf->getBuffer(), 351);
+}
+
+uint16_t bufferedMatrixCRC(uint8_t board, uint8_t rotation,
+                           IS3741_order order) {
+  if (board == 0) {
+    Adafruit_IS31FL3741_EVB_buffered m(order);
+    return bufferedCRC(&m, &m, rotation);
+  } else if (board == 1) {
+    Adafruit_IS31FL3741_QT_buffered m(order);
+    return bufferedCRC(&m, &m, rotation);
+  }
+  Adafruit_EyeLights_buffered m(false, order);
+  return bufferedCRC(&m, &m, rotation);
+}
+
+uint16_t bufferedRingsCRC(IS3741_order order) {
+  Adafruit_EyeLights_buffered m(false, order);
+  memset(m.getBuffer(), 0, 351);
+  for (int16_t i = 0; i < 24; i++) {
+    m.left_ring.setPixelColor(i, ringColor(i, 0));
+    m.right_ring.setPixelColor(i, ringColor(i, 1));
+  }
+  return crc16(m.getBuffer(), 351);
+}
+
+// CRC of the LED PWM registers in a chip model
+uint16_t modelCRC(Adafruit_IS31FL3741_Model *model) {
+  uint16_t crc = 0xFFFF;
+  for (uint16_t i = 0; i < 351; i++) {
+    crc ^= (uint16_t)model->getPWM(i) << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+    }
+  }
+  return crc;
+}
+
+// Direct objects are only in the default (BGR) color order, as each one
+// can only begin() once, and color order is handled by code shared with
+// the buffered classes anyway.
+Adafruit_IS31FL3741_EVB evb;
+Adafruit_IS31FL3741_QT qt;
+Adafruit_EyeLights eyelights;
+
+void testDirect(void) {
+  Adafruit_IS31FL3741_Model chipModel;
+  Adafruit_IS31FL3741_Model *model = &chipModel;
+  Adafruit_GFX *gfx[] = { &evb, &qt, &eyelights };
+  Adafruit_IS31FL3741 *chip[] = { &evb, &qt, &eyelights };
+  for (uint8_t board = 0; board < 3; board++) {
+    chip[board]->setTrace(model); // Model sees begin()'s reset, etc.
+    chip[board]->begin(IS3741_ADDR_DEFAULT, i2c);
+    for (uint8_t rotation = 0; rotation < 4; rotation++) {
+      chip[board]->fill(0); // Clear chip and model
+      drawPattern(gfx[board], rotation);
+      check("direct", board, rotation, 5, modelCRC(model),
+            pgm_read_word(&goldenMatrix[board][rotation][5]));
+    }
+    if (board == 2) {
+      chip[board]->fill(0);
+      for (int16_t i = 0; i < 24; i++) {
+        eyelights.left_ring.setPixelColor(i, ringColor(i, 0));
+        eyelights.right_ring.setPixelColor(i, ringColor(i, 1));
+      }
+      check("direct rings", board, 0, 5, modelCRC(model),
+            pgm_read_word(&goldenRings[5]));
+    }
+    chip[board]->setTrace(NULL);
+  }
+  if (model->errors()) {
+    failures++;
+    Serial.print("FAIL direct: ");
+    Serial.print(model->errors());
+    Serial.println(" writes a real chip would reject");
+  }
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) delay(10); // Wait for Serial Monitor on native USB boards
+  Serial.println("IS31FL3741 pixel mapping self-test");
+
+  for (uint8_t board = 0; board < 3; board++) {
+    for (uint8_t rotation = 0; rotation < 4; rotation++) {
+      for (uint8_t order = 0; order < 6; order++) {
+        check("buffered", board, rotation, order,
+              bufferedMatrixCRC(board, rotation, orders[order]),
+              pgm_read_word(&goldenMatrix[board][rotation][order]));
+      }
+    }
+  }
+  for (uint8_t order = 0; order < 6; order++) {
+    check("buffered rings", 2, 0, order, bufferedRingsCRC(orders[order]),
+          pgm_read_word(&goldenRings[order]));
+  }
+
+  // Probe for chip; direct tests only if found
+  if (evb.begin(IS3741_ADDR_DEFAULT, i2c)) {
+    testDirect();
+  } else {
+    Serial.println("IS31FL3741 not found, skipping direct classes");
+  }
+
+  Serial.println(failures ? "FAILED" : "PASSED");
+}
+
+void loop() {
+}
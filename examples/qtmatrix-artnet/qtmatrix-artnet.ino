@@ -0,0 +1,79 @@
+// Art-Net / E1.31 (sACN) receiver example for the Adafruit IS31FL3741
+// 13x9 PWM RGB LED Matrix Driver w/STEMMA QT / Qwiic connector, for ESP32
+// boards. Show-control software sends DMX universes over WiFi; universe 0
+// drives LED buffer elements 0-179 (register page 0) and universe 1
+// drives 180-350 (page 1). Channels map straight to LED elements in the
+// chip's register order, not pixels -- see getLEDIndices() or the mapping
+// self-test example for which elements are which pixel's R, G and B.
+
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#include <Adafruit_IS31FL3741.h>
+
+const char *ssid = "YOUR_SSID";
+const char *password = "YOUR_PASSWORD";
+
+Adafruit_IS31FL3741_QT_buffered matrix;
+
+// Some boards have just one I2C interface, but some have more...
+TwoWire *i2c = &Wire; // e.g. change this to &Wire1 for QT Py RP2040
+
+// Universe, first channel, channel count, first LED element, object
+const IS3741_dmxMap dmxMap[] = {
+    {0, 1, 180, 0, &matrix},
+    {1, 1, 171, 180, &matrix},
+};
+Adafruit_IS31FL3741_DMX dmx(dmxMap, sizeof dmxMap / sizeof dmxMap[0]);
+
+WiFiUDP artnet, e131;
+uint8_t packet[640]; // Big enough for largest Art-Net or E1.31 packet
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("Adafruit QT RGB Matrix Art-Net/E1.31 Receiver");
+
+  if (! matrix.begin(IS3741_ADDR_DEFAULT, i2c)) {
+    Serial.println("IS41 not found");
+    while (1);
+  }
+
+  Serial.println("IS41 found!");
+
+  i2c->setClock(1000000);
+  matrix.setLEDscaling(0xFF);
+  matrix.setGlobalCurrent(0xFF);
+  matrix.enable(true);
+
+  WiFi.begin(ssid, password);
+  while (WiFi.status() != WL_CONNECTED) delay(100);
+  Serial.print("Listening at ");
+  Serial.println(WiFi.localIP());
+
+  artnet.begin(IS3741_ARTNET_PORT);
+  e131.begin(IS3741_E131_PORT); // Unicast; beginMulticast() for multicast
+}
+
+void loop() {
+  WiFiUDP *udp[] = {&artnet, &e131};
+  for (uint8_t i = 0; i < 2; i++) {
+    int len;
+    while ((len = udp[i]->parsePacket()) > 0) {
+      len = udp[i]->read(packet, sizeof packet);
+      dmx.handlePacket(packet, len);
+    }
+  }
+
+  static uint32_t lastReport = 0;
+  if ((millis() - lastReport) >= 5000) {
+    lastReport = millis();
+    Serial.print("Packets: ");
+    Serial.print(dmx.packets());
+    Serial.print(", dropped: ");
+    Serial.print(dmx.dropped());
+    Serial.print(", frames: ");
+    Serial.print(dmx.frames());
+    Serial.print(" (");
+    Serial.print(dmx.partial());
+    Serial.println(" partial)");
+  }
+}
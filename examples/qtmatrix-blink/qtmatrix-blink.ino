@@ -0,0 +1,62 @@
+// Hardware blink example for the Adafruit IS31FL3741 13x9 PWM RGB LED
+// Matrix Driver w/STEMMA QT / Qwiic connector. Rather than erasing and
+// redrawing the matrix, the blinker object switches the chip's shutdown
+// state on and off -- a few tiny I2C writes per edge (one if nothing
+// else touched the chip in between), and the picture is preserved.
+// Alternates between a slow blink and a fast strobe.
+
+#include <Adafruit_IS31FL3741.h>
+
+Adafruit_IS31FL3741_QT_buffered matrix;
+// If colors appear wrong on matrix, try invoking constructor like so:
+// Adafruit_IS31FL3741_QT_buffered matrix(IS3741_RBG);
+
+Adafruit_IS31FL3741_Blink blinker(&matrix);
+
+// Some boards have just one I2C interface, but some have more...
+TwoWire *i2c = &Wire; // e.g. change this to &Wire1 for QT Py RP2040
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("Adafruit QT RGB Matrix Blink Test");
+
+  if (! matrix.begin(IS3741_ADDR_DEFAULT, i2c)) {
+    Serial.println("IS41 not found");
+    while (1);
+  }
+
+  Serial.println("IS41 found!");
+
+  i2c->setClock(800000);
+
+  matrix.setLEDscaling(0xFF);
+  matrix.setGlobalCurrent(0xFF);
+  matrix.enable(true);
+
+  // Draw something once. It's never redrawn, only blinked.
+  for (int y = 0; y < matrix.height(); y++) {
+    for (int x = 0; x < matrix.width(); x++) {
+      uint32_t color = matrix.ColorHSV((x + y) * 65536 / 22);
+      matrix.drawPixel(x, y, matrix.color565(color));
+    }
+  }
+  matrix.show();
+}
+
+uint32_t lastSwitch = 0;
+bool strobe = true;
+
+void loop() {
+  if ((millis() - lastSwitch) >= 5000) { // Every 5 seconds...
+    lastSwitch = millis();
+    strobe = !strobe;
+    if (strobe) {
+      Serial.println("Strobe");
+      blinker.start(100, 25); // 100 ms cycle, lit ~10% of that
+    } else {
+      Serial.println("Blink");
+      blinker.start(1000); // 1 second cycle, lit half the time
+    }
+  }
+  blinker.poll(); // Call often, this does the on/off switching
+}
@@ -0,0 +1,76 @@
+// I2C bus timing model example for the Adafruit IS31FL3741 13x9 PWM RGB
+// LED Matrix Driver w/STEMMA QT / Qwiic connector. Prints predicted bus
+// time and frame rate limits for buffered show(), fill() and direct
+// per-pixel drawing at several I2C clock rates and buffer sizes -- this
+// part needs no matrix connected. If a matrix IS connected, a BusModel
+// is also attached as a trace sink to cost the library's actual traffic,
+// and the measured time is printed for comparison. The difference is
+// software overhead in the I2C driver, which varies by board (see
+// setOverhead() to include it in predictions).
+
+#include <Adafruit_IS31FL3741.h>
+
+Adafruit_IS31FL3741_QT_buffered matrix;
+
+// Some boards have just one I2C interface, but some have more...
+TwoWire *i2c = &Wire; // e.g. change this to &Wire1 for QT Py RP2040
+
+const uint32_t clocks[] = { 100000, 400000, 800000, 1000000 };
+const uint16_t buffers[] = { 32, 128, 256 };
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) delay(10); // Wait for Serial Monitor on native USB boards
+  Serial.println("Adafruit QT RGB Matrix Bus Model Test");
+
+  Serial.println("Predicted bus time, microseconds (max frames/sec):");
+  Serial.println("Clock\tshow() w/32, 128, 256 byte buf\tfill()\t13x9 px");
+  for (uint8_t c = 0; c < sizeof clocks / sizeof clocks[0]; c++) {
+    Serial.print(clocks[c]);
+    for (uint8_t b = 0; b < sizeof buffers / sizeof buffers[0]; b++) {
+      uint32_t us =
+        Adafruit_IS31FL3741_BusModel::predictShow(clocks[c], buffers[b]);
+      Serial.print('\t');
+      Serial.print(us);
+      Serial.print(" (");
+      Serial.print(1000000 / us);
+      Serial.print(')');
+    }
+    Serial.print('\t');
+    Serial.print(Adafruit_IS31FL3741_BusModel::predictFill(clocks[c]));
+    Serial.print('\t');
+    Serial.println(Adafruit_IS31FL3741_BusModel::predictPixels(clocks[c],
+                                                               13 * 9));
+  }
+
+  if (! matrix.begin(IS3741_ADDR_DEFAULT, i2c)) {
+    Serial.println("IS41 not found, can't compare with actual transfers.");
+    return;
+  }
+
+  // Model this board's actual clock and buffer size, then trace show()
+  uint32_t clock = 800000;
+  i2c->setClock(clock);
+  Adafruit_IS31FL3741_BusModel model(clock, 32); // Change for your board
+  matrix.show(); // Do one untraced first, so starting page is typical
+  matrix.setTrace(&model);
+  uint32_t t = micros();
+  matrix.show();
+  t = micros() - t;
+  matrix.setTrace(NULL);
+
+  Serial.print("show() at ");
+  Serial.print(clock);
+  Serial.print(" Hz: model ");
+  Serial.print(model.busMicros());
+  Serial.print(" us (");
+  Serial.print(model.transactions());
+  Serial.print(" transactions, ");
+  Serial.print(model.pageMicros());
+  Serial.print(" us page selects), measured ");
+  Serial.print(t);
+  Serial.println(" us");
+}
+
+void loop() {
+}
@@ -0,0 +1,61 @@
+// White balance & calibration example for the Adafruit IS31FL3741 13x9 PWM
+// RGB LED Matrix Driver w/STEMMA QT / Qwiic connector. The chip has a
+// scaling register for every LED, applied to all PWM values in hardware.
+// setWhiteBalance() loads these with per-color gains (and optionally a
+// per-LED calibration table, e.g. measured with a camera or light meter
+// to even out LED-to-LED variation), so drawing code needn't do any color
+// correction of its own. This cycles through the white balance presets
+// on a full-white matrix, a couple seconds each.
+
+#include <Adafruit_IS31FL3741.h>
+
+Adafruit_IS31FL3741_QT_buffered matrix;
+// If colors appear wrong on matrix, try invoking constructor like so:
+// Adafruit_IS31FL3741_QT_buffered matrix(IS3741_RBG);
+
+// Some boards have just one I2C interface, but some have more...
+TwoWire *i2c = &Wire; // e.g. change this to &Wire1 for QT Py RP2040
+
+// Per-LED calibration, 351 values indexed same as matrix.getBuffer().
+// A real table would come from measuring a specific panel, and would
+// usually be a const PROGMEM array (pass true for progmem below) or read
+// from EEPROM. This one's made up in setup() with a few LEDs dimmed, just
+// so there's something to see.
+uint8_t calibration[351];
+
+const uint32_t presets[] = {IS3741_WHITE_NONE, IS3741_WHITE_NEUTRAL,
+                            IS3741_WHITE_WARM, IS3741_WHITE_COOL};
+const char *names[] = {"None", "Neutral", "Warm", "Cool"};
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("Adafruit QT RGB Matrix White Balance Test");
+
+  if (! matrix.begin(IS3741_ADDR_DEFAULT, i2c)) {
+    Serial.println("IS41 not found");
+    while (1);
+  }
+
+  Serial.println("IS41 found!");
+
+  i2c->setClock(800000);
+
+  for (uint16_t i = 0; i < 351; i++) {
+    calibration[i] = (i % 7) ? 255 : 160;
+  }
+
+  matrix.setGlobalCurrent(0x40); // Full white is bright, go easy
+  matrix.enable(true);
+  matrix.fill(0xFFFF); // White, drawn once; only scaling changes below
+  matrix.show();
+}
+
+uint8_t preset = 0;
+
+void loop() {
+  Serial.print("White balance: ");
+  Serial.println(names[preset]);
+  matrix.setWhiteBalance(presets[preset], calibration);
+  preset = (preset + 1) % 4;
+  delay(2000);
+}
@@ -0,0 +1,72 @@
+// Delta update example for the Adafruit IS31FL3741 13x9 PWM RGB LED Matrix
+// Driver w/STEMMA QT / Qwiic connector. A mostly-static scene -- a fixed
+// border with a dot crawling across the middle -- where DeltaShow sends
+// only the 16-byte blocks of LED data that changed each frame, rather
+// than the whole buffer. Bytes sent per frame are measured with a
+// BusModel trace sink and printed alongside those of a full show().
+
+#include <Adafruit_IS31FL3741.h>
+
+Adafruit_IS31FL3741_QT_buffered matrix;
+Adafruit_IS31FL3741_DeltaShow delta(&matrix);
+Adafruit_IS31FL3741_BusModel model;
+
+// Some boards have just one I2C interface, but some have more...
+TwoWire *i2c = &Wire; // e.g. change this to &Wire1 for QT Py RP2040
+
+uint8_t x = 0;     // Dot position
+uint32_t last = 0; // Time of last dot move
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("Adafruit QT RGB Matrix Delta Update Test");
+
+  if (! matrix.begin(IS3741_ADDR_DEFAULT, i2c)) {
+    Serial.println("IS41 not found");
+    while (1);
+  }
+
+  Serial.println("IS41 found!");
+
+  i2c->setClock(800000);
+
+  matrix.setLEDscaling(0xFF);
+  matrix.setGlobalCurrent(0xFF);
+  matrix.enable(true);
+
+  matrix.drawRect(0, 0, matrix.width(), matrix.height(), 0x001F);
+
+  // Cost of a full show(), for comparison
+  matrix.setTrace(&model);
+  matrix.show();
+  matrix.setTrace(NULL);
+  Serial.print("Full show(): ");
+  Serial.print(model.bytes());
+  Serial.println(" bytes");
+  delta.invalidate(); // Chip was written outside delta, resend all once
+}
+
+void loop() {
+  // Only the drawing code knows when it drew; touch() records that, so
+  // frames where nothing was touched skip even the comparison.
+  if ((millis() - last) >= 100) { // Move dot 10 times/sec
+    last = millis();
+    matrix.drawPixel(1 + x, 4, 0);
+    x = (x + 1) % (matrix.width() - 2);
+    matrix.drawPixel(1 + x, 4, 0xF800);
+    delta.touch();
+  }
+
+  if (delta.changed()) {
+    model.reset();
+    matrix.setTrace(&model);
+    delta.show();
+    matrix.setTrace(NULL);
+    Serial.print("Delta: ");
+    Serial.print(delta.blocksSent());
+    Serial.print(" blocks, ");
+    Serial.print(model.bytes());
+    Serial.println(" bytes");
+  }
+  delay(20);
+}
@@ -0,0 +1,85 @@
+// Fixed frame rate example for the Adafruit IS31FL3741 13x9 PWM RGB LED
+// Matrix Driver w/STEMMA QT / Qwiic connector. Rather than show() and a
+// fixed delay(), which runs slower as drawing or I2C transfer take longer,
+// a FramePacer object sends each frame and waits only whatever time is
+// left in the frame period. Every couple of seconds, timing stats are
+// printed to the Serial Monitor: if 'show' time is larger than 'draw'
+// time, the sketch is limited by the I2C bus (try a faster setClock());
+// otherwise it's the drawing code.
+
+#include <Adafruit_IS31FL3741.h>
+
+Adafruit_IS31FL3741_QT_buffered matrix;
+// If colors appear wrong on matrix, try invoking constructor like so:
+// Adafruit_IS31FL3741_QT_buffered matrix(IS3741_RBG);
+
+Adafruit_IS31FL3741_FramePacer pacer(&matrix, 50); // 50 frames/sec
+
+// Some boards have just one I2C interface, but some have more...
+TwoWire *i2c = &Wire; // e.g. change this to &Wire1 for QT Py RP2040
+
+uint16_t hue = 0;       // Rainbow offset, changes each frame
+uint8_t load = 0;       // Drawing passes this frame, varies over time
+uint32_t lastPrint = 0; // millis() of last stats print
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("Adafruit QT RGB Matrix Frame Pacing Test");
+
+  if (! matrix.begin(IS3741_ADDR_DEFAULT, i2c)) {
+    Serial.println("IS41 not found");
+    while (1);
+  }
+
+  Serial.println("IS41 found!");
+
+  // By default the LED controller communicates over I2C at 400 KHz.
+  // Arduino Uno can usually do 800 KHz, and 32-bit microcontrollers 1 MHz.
+  i2c->setClock(800000);
+
+  // Set brightness to max and bring controller out of shutdown state
+  matrix.setLEDscaling(0xFF);
+  matrix.setGlobalCurrent(0xFF);
+  matrix.enable(true);
+}
+
+void loop() {
+  // Draw the same rainbow several times over, number of passes ramping
+  // up and down, to simulate a scene that's sometimes busy.
+  uint8_t passes = 1 + ((load < 128) ? load : 255 - load) / 8;
+  for (uint8_t p = 0; p < passes; p++) {
+    for (int x = 0; x < matrix.width(); x++) {
+      uint16_t color = matrix.color565(matrix.ColorHSV(hue + x * 4000));
+      for (int y = 0; y < matrix.height(); y++) {
+        matrix.drawPixel(x, y, color);
+      }
+    }
+  }
+  hue += 500;
+  load++;
+
+  pacer.show(); // Replaces matrix.show() and delay()
+
+  if ((millis() - lastPrint) >= 2000) {
+    const IS3741_frameStats *stats = pacer.getStats();
+    Serial.print("fps: ");
+    Serial.print(stats->fps);
+    Serial.print(" missed: ");
+    Serial.print(stats->missed);
+    Serial.print(" draw avg/max us: ");
+    Serial.print(stats->renderAvg);
+    Serial.print('/');
+    Serial.print(stats->renderMax);
+    Serial.print(" show avg/max us: ");
+    Serial.print(stats->showAvg);
+    Serial.print('/');
+    Serial.print(stats->showMax);
+    Serial.print(" jitter:");
+    for (uint8_t i = 0; i < IS3741_JITTER_BINS; i++) {
+      Serial.print(' ');
+      Serial.print(stats->jitter[i]);
+    }
+    Serial.println();
+    lastPrint = millis();
+  }
+}
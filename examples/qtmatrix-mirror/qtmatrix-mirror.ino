@@ -0,0 +1,73 @@
+// Mirrored displays example for the Adafruit IS31FL3741 13x9 PWM RGB LED
+// Matrix Driver w/STEMMA QT / Qwiic connector. Two (or up to five) matrices
+// show the same scrolling text, but only the first one needs a RAM buffer
+// and the drawing is done just once. Each additional matrix needs its own
+// I2C address (set with the solder jumpers on the back), and here the
+// second one is mounted upside-down -- e.g. back-to-back with the first,
+// both facing outward -- which the mirror group corrects for.
+
+#include <Adafruit_IS31FL3741.h>
+
+Adafruit_IS31FL3741_QT_buffered front; // All drawing goes here
+Adafruit_IS31FL3741 back;              // Unbuffered, just a few bytes
+Adafruit_IS31FL3741_Mirror mirror(&front);
+
+// Some boards have just one I2C interface, but some have more...
+TwoWire *i2c = &Wire; // e.g. change this to &Wire1 for QT Py RP2040
+
+char text[] = "ADAFRUIT!";
+int16_t text_x = 13; // Start off right edge
+int16_t text_min;    // Pos. where text resets (calc'd later)
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("Adafruit QT RGB Matrix Mirror Test");
+
+  if (! front.begin(IS3741_ADDR_DEFAULT, i2c) ||
+      ! back.begin(IS3741_ADDR_DEFAULT + 1, i2c)) {
+    Serial.println("IS41 not found");
+    while (1);
+  }
+
+  Serial.println("IS41 found!");
+
+  // By default the LED controller communicates over I2C at 400 KHz.
+  // Arduino Uno can usually do 800 KHz, and 32-bit microcontrollers 1 MHz.
+  i2c->setClock(800000);
+
+  // Second matrix is turned 180 degrees. If its colors are ordered
+  // differently, pass that too, e.g. mirror.add(&back, 2, IS3741_RBG);
+  mirror.add(&back, 2);
+
+  // Set brightness to max and bring controllers out of shutdown state
+  front.setLEDscaling(0xFF);
+  front.setGlobalCurrent(0xFF);
+  front.enable(true);
+  back.setLEDscaling(0xFF);
+  back.setGlobalCurrent(0xFF);
+  back.enable(true);
+
+  front.setTextWrap(false);
+  int16_t x1, y1;
+  uint16_t w, h;
+  front.getTextBounds(text, 0, 0, &x1, &y1, &w, &h);
+  text_min = -w; // Off left edge this many pixels
+}
+
+uint16_t hue = 0;
+
+void loop() {
+  front.fill(0);
+  front.setCursor(text_x, 1);
+  for (uint8_t i = 0; i < strlen(text); i++) {
+    front.setTextColor(front.color565(front.ColorHSV(hue + i * 65536 / 9)));
+    front.print(text[i]);
+  }
+  mirror.show(); // Sends front's buffer to both matrices
+
+  if (--text_x < text_min) {
+    text_x = front.width();
+  }
+  hue += 1024;
+  delay(50);
+}
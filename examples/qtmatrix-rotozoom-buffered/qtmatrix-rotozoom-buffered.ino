@@ -0,0 +1,69 @@
+// Spinning & zooming bitmap example for the Adafruit IS31FL3741 13x9 PWM
+// RGB LED Matrix Driver w/STEMMA QT / Qwiic connector. Uses the buffered
+// matrix class and its drawAffine() function, which does all the rotation
+// and scaling math in fixed-point integers -- no floating-point needed,
+// so this runs at a good clip even on small chips like SAMD21.
+
+#include <Adafruit_IS31FL3741.h>
+
+Adafruit_IS31FL3741_QT_buffered matrix;
+// If colors appear wrong on matrix, try invoking constructor like so:
+// Adafruit_IS31FL3741_QT_buffered matrix(IS3741_RBG);
+
+// Some boards have just one I2C interface, but some have more...
+TwoWire *i2c = &Wire; // e.g. change this to &Wire1 for QT Py RP2040
+
+// An 8x8 RGB565 arrow, rainbow colors top to bottom. Same format as used
+// with GFX's drawRGBBitmap(), but must be in PROGMEM for drawAffine().
+const uint16_t PROGMEM arrow[8 * 8] = {
+    0x0000, 0x0000, 0x0000, 0xF800, 0xF800, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0xFDE0, 0xFDE0, 0xFDE0, 0xFDE0, 0x0000, 0x0000,
+    0x0000, 0x7FE0, 0x7FE0, 0x7FE0, 0x7FE0, 0x7FE0, 0x7FE0, 0x0000,
+    0x07E7, 0x07E7, 0x07E7, 0x07E7, 0x07E7, 0x07E7, 0x07E7, 0x07E7,
+    0x0000, 0x0000, 0x07FF, 0x07FF, 0x07FF, 0x07FF, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x01FF, 0x01FF, 0x01FF, 0x01FF, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x781F, 0x781F, 0x781F, 0x781F, 0x0000, 0x0000,
+    0x0000, 0x0000, 0xF817, 0xF817, 0xF817, 0xF817, 0x0000, 0x0000,
+};
+
+IS3741_affine xform; // Transform is recalculated every frame
+uint16_t angle = 0;  // Rotation, 0-65535 is one full turn
+uint16_t pulse = 0;  // For zooming in & out
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("Adafruit QT RGB Matrix Rotozoom Test");
+
+  if (! matrix.begin(IS3741_ADDR_DEFAULT, i2c)) {
+    Serial.println("IS41 not found");
+    while (1);
+  }
+
+  Serial.println("IS41 found!");
+
+  // By default the LED controller communicates over I2C at 400 KHz.
+  // Arduino Uno can usually do 800 KHz, and 32-bit microcontrollers 1 MHz.
+  i2c->setClock(800000);
+
+  // Set brightness to max and bring controller out of shutdown state
+  matrix.setLEDscaling(0xFF);
+  matrix.setGlobalCurrent(0xFF);
+  matrix.enable(true);
+}
+
+void loop() {
+  // Zoom oscillates from 0.75X to 1.75X using the fixed-point sine func.
+  // sin16() returns +/-32767, which happens to be +/-0.5 in 16.16 format.
+  int32_t zoom = IS3741_FIXED(1.25) + matrix.sin16(pulse);
+  // Rotate around the middle of the bitmap (4,4), placing that point at
+  // the middle of the matrix (6.5,4.5).
+  matrix.setRotoZoom(&xform, angle, zoom, IS3741_FIXED(4), IS3741_FIXED(4),
+                     IS3741_FIXED(6.5), IS3741_FIXED(4.5));
+
+  matrix.fill(0);                               // Clear background,
+  matrix.drawAffine(arrow, 8, 8, &xform, true); // draw w/bilinear filter
+  matrix.show(); // Buffered matrix MUST use show() to update!
+
+  angle += 600;
+  pulse += 300;
+}
@@ -0,0 +1,64 @@
+// I2C transaction trace example for the Adafruit IS31FL3741 13x9 PWM RGB
+// LED Matrix Driver w/STEMMA QT / Qwiic connector. Every I2C transfer the
+// library makes can be recorded by a "trace sink" passed to setTrace().
+// Here the most recent transfers are kept in a RAM ring buffer and listed
+// to the Serial Monitor, one line each: time in microseconds, I2C address,
+// W(rite) or R(ead), then bytes sent (register address first). Handy for
+// seeing exactly what reaches the chip when tracking down a glitch.
+// For offline analysis, use dump() instead of list() to write the binary
+// form to an SD card File, or attach an Adafruit_IS31FL3741_TracePrint
+// sink to log everything as it happens; either can be played back later
+// with Adafruit_IS31FL3741_TraceReplay, onto real hardware or into an
+// Adafruit_IS31FL3741_Model to check the resulting register state.
+
+#include <Adafruit_IS31FL3741.h>
+
+Adafruit_IS31FL3741_QT_buffered matrix;
+// If colors appear wrong on matrix, try invoking constructor like so:
+// Adafruit_IS31FL3741_QT_buffered matrix(IS3741_RBG);
+
+// Some boards have just one I2C interface, but some have more...
+TwoWire *i2c = &Wire; // e.g. change this to &Wire1 for QT Py RP2040
+
+uint8_t traceMem[512]; // Oldest records are discarded when full
+Adafruit_IS31FL3741_TraceBuffer trace(traceMem, sizeof traceMem);
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) delay(10); // Wait for Serial Monitor on native USB boards
+  Serial.println("Adafruit QT RGB Matrix Trace Test");
+
+  matrix.setTrace(&trace); // Start recording, even during begin()
+
+  if (! matrix.begin(IS3741_ADDR_DEFAULT, i2c)) {
+    Serial.println("IS41 not found");
+    trace.list(&Serial); // Trace shows what the chip did (not) answer
+    while (1);
+  }
+
+  Serial.println("IS41 found!");
+
+  // Set brightness to max and bring controller out of shutdown state
+  matrix.setLEDscaling(0xFF);
+  matrix.setGlobalCurrent(0xFF);
+  matrix.enable(true);
+
+  Serial.println("Startup:");
+  trace.list(&Serial);
+  trace.clear();
+
+  // Draw one frame and see how show() moves it over the bus
+  matrix.fill(matrix.color565(0, 0, 255));
+  matrix.drawPixel(0, 0, matrix.color565(255, 0, 0));
+  matrix.show();
+
+  Serial.println("First frame:");
+  trace.list(&Serial);
+  Serial.print(trace.dropped());
+  Serial.println(" older records didn't fit in buffer");
+
+  matrix.setTrace(NULL); // Stop recording
+}
+
+void loop() {
+}
@@ -0,0 +1,77 @@
+// Dual-core example for the Adafruit IS31FL3741 13x9 PWM RGB LED Matrix
+// Driver w/STEMMA QT / Qwiic connector. On RP2040 boards (using the
+// Earle Philhower Arduino core), the first core draws a plasma effect as
+// fast as it can while the second core sends frames over I2C, so neither
+// waits on the other. A triple buffer passes frames between them. On other
+// boards this just does both steps in turn, so it still runs. Needs about
+// 1.5 KB RAM, so not for Arduino Uno.
+
+#include <Adafruit_IS31FL3741.h>
+
+Adafruit_IS31FL3741_QT_buffered ledmatrix;
+// If colors appear wrong on matrix, try invoking constructor like so:
+// Adafruit_IS31FL3741_QT_buffered ledmatrix(IS3741_RBG);
+
+Adafruit_IS31FL3741_TripleBuffer frames(&ledmatrix);
+Adafruit_IS31FL3741_Effects effects(&ledmatrix);
+
+// Some boards have just one I2C interface, but some have more...
+TwoWire *i2c = &Wire; // e.g. change this to &Wire1 for QT Py RP2040
+
+volatile bool ready = false; // Set true once matrix is initialized
+uint32_t drawn = 0;
+volatile uint32_t sent = 0; // Incremented by whichever core sends
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("Adafruit QT RGB Matrix Triple Buffer Test");
+
+  if (! ledmatrix.begin(IS3741_ADDR_DEFAULT, i2c)) {
+    Serial.println("IS41 not found");
+    while (1);
+  }
+
+  Serial.println("IS41 found!");
+
+  // By default the LED controller communicates over I2C at 400 KHz.
+  // Arduino Uno can usually do 800 KHz, and 32-bit microcontrollers 1 MHz.
+  i2c->setClock(1000000);
+
+  // Set brightness to max and bring controller out of shutdown state
+  ledmatrix.setLEDscaling(0xFF);
+  ledmatrix.setGlobalCurrent(0xFF);
+  ledmatrix.enable(true); // bring out of shutdown
+  ready = true;
+}
+
+void loop() {
+  effects.plasma();  // Draw into ledmatrix as usual, but then...
+  frames.publish();  // hand off the frame instead of calling show()
+  drawn++;
+
+#if !defined(ARDUINO_ARCH_RP2040)
+  if (frames.show()) sent++; // Single core, send it right here
+#endif
+
+  static uint32_t last = 0;
+  if ((millis() - last) >= 1000) { // Once per second, print stats
+    last = millis();
+    Serial.print("Frames drawn: ");
+    Serial.print(drawn);
+    Serial.print(", sent: ");
+    Serial.println(sent);
+    drawn = sent = 0;
+  }
+}
+
+#if defined(ARDUINO_ARCH_RP2040)
+// Second core does nothing but send frames to the matrix. All I2C traffic
+// happens here once setup() has finished.
+void setup1() {
+  while (!ready);
+}
+
+void loop1() {
+  if (frames.show()) sent++;
+}
+#endif
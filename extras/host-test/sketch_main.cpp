@@ -0,0 +1,28 @@
+// Runs an example sketch on the host: SKETCH is the .ino path (see the
+// Makefile), Serial goes to stdout, and loop() runs LOOPS times.
+/// @cond HOST_TEST
+
+#include <Arduino.h>
+
+class HostSerial : public Stream {
+public:
+  void begin(long baud) { (void)baud; }
+  size_t write(uint8_t c) { return (putchar(c) == EOF) ? 0 : 1; }
+  int available(void) { return 0; }
+  int read(void) { return -1; }
+  int peek(void) { return -1; }
+  operator bool(void) { return true; }
+};
+
+HostSerial Serial;
+
+#include SKETCH
+
+int main(void) {
+  setup();
+  for (int i = 0; i < LOOPS; i++)
+    loop();
+  return 0;
+}
+
+/// @endcond
@@ -0,0 +1,54 @@
+// Stand-in for Adafruit BusIO's register helpers, single-byte registers
+// only, going through the simulated I2C device.
+/// @cond HOST_TEST
+
+#ifndef _HOST_ADAFRUIT_BUSIO_REGISTER_H_
+#define _HOST_ADAFRUIT_BUSIO_REGISTER_H_
+
+#include <Adafruit_I2CDevice.h>
+
+class Adafruit_BusIO_Register {
+public:
+  Adafruit_BusIO_Register(Adafruit_I2CDevice *i2cdevice, uint16_t reg_addr,
+                          uint8_t width = 1)
+      : _dev(i2cdevice), _addr(reg_addr) {
+    (void)width;
+  }
+  bool write(uint32_t value, uint8_t numbytes = 0) {
+    (void)numbytes;
+    uint8_t buf[2] = {(uint8_t)_addr, (uint8_t)value};
+    return _dev->write(buf, 2);
+  }
+  uint32_t read(void) {
+    uint8_t reg = _addr, value;
+    _dev->write_then_read(&reg, 1, &value, 1);
+    return value;
+  }
+
+private:
+  Adafruit_I2CDevice *_dev;
+  uint16_t _addr;
+};
+
+class Adafruit_BusIO_RegisterBits {
+public:
+  Adafruit_BusIO_RegisterBits(Adafruit_BusIO_Register *reg, uint8_t bits,
+                              uint8_t shift)
+      : _reg(reg), _bits(bits), _shift(shift) {}
+  bool write(uint32_t data) {
+    uint32_t mask = (1UL << _bits) - 1;
+    uint32_t value = _reg->read() & ~(mask << _shift);
+    return _reg->write(value | ((data & mask) << _shift));
+  }
+  uint32_t read(void) {
+    return (_reg->read() >> _shift) & ((1UL << _bits) - 1);
+  }
+
+private:
+  Adafruit_BusIO_Register *_reg;
+  uint8_t _bits, _shift;
+};
+
+#endif // _HOST_ADAFRUIT_BUSIO_REGISTER_H_
+
+/// @endcond
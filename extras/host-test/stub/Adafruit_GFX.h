@@ -0,0 +1,92 @@
+// Stand-in for Adafruit_GFX with just the drawing calls the library and
+// sketches use, done the slow obvious way through drawPixel(). Text is
+// stubbed out (each character marks one pixel), fonts aren't supported.
+/// @cond HOST_TEST
+
+#ifndef _HOST_ADAFRUIT_GFX_H_
+#define _HOST_ADAFRUIT_GFX_H_
+
+#include <Arduino.h>
+
+struct GFXfont;
+
+class Adafruit_GFX : public Print {
+public:
+  Adafruit_GFX(int16_t w, int16_t h)
+      : WIDTH(w), HEIGHT(h), _width(w), _height(h) {}
+  virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+  virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    for (int16_t i = 0; i < w; i++)
+      drawPixel(x + i, y, color);
+  }
+  virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                        uint16_t color) {
+    for (int16_t j = 0; j < h; j++)
+      drawFastHLine(x, y + j, w, color);
+  }
+  virtual void fillScreen(uint16_t color) {
+    fillRect(0, 0, _width, _height, color);
+  }
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    drawFastHLine(x, y, w, color);
+    drawFastHLine(x, y + h - 1, w, color);
+    for (int16_t j = 1; j < h - 1; j++) {
+      drawPixel(x, y + j, color);
+      drawPixel(x + w - 1, y + j, color);
+    }
+  }
+  void setRotation(uint8_t r) {
+    rotation = r & 3;
+    _width = (rotation & 1) ? HEIGHT : WIDTH;
+    _height = (rotation & 1) ? WIDTH : HEIGHT;
+  }
+  uint8_t getRotation(void) const { return rotation; }
+  int16_t width(void) const { return _width; }
+  int16_t height(void) const { return _height; }
+  size_t write(uint8_t c) {
+    (void)c;
+    drawPixel(cursor_x, cursor_y, textcolor);
+    cursor_x += 6;
+    return 1;
+  }
+  void setCursor(int16_t x, int16_t y) {
+    cursor_x = x;
+    cursor_y = y;
+  }
+  void setTextColor(uint16_t c) { textcolor = c; }
+  void setTextWrap(bool w) { (void)w; }
+  void getTextBounds(const char *str, int16_t x, int16_t y, int16_t *x1,
+                     int16_t *y1, uint16_t *w, uint16_t *h) {
+    *x1 = x;
+    *y1 = y;
+    *w = strlen(str) * 6;
+    *h = 8;
+  }
+
+protected:
+  const int16_t WIDTH, HEIGHT;
+  int16_t _width, _height;
+  int16_t cursor_x = 0, cursor_y = 0;
+  uint16_t textcolor = 0xFFFF;
+  uint8_t rotation = 0;
+};
+
+class GFXcanvas16 : public Adafruit_GFX {
+public:
+  GFXcanvas16(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
+    buffer = (uint16_t *)calloc(w * h, sizeof(uint16_t));
+  }
+  ~GFXcanvas16(void) { free(buffer); }
+  void drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if ((x >= 0) && (y >= 0) && (x < _width) && (y < _height))
+      buffer[y * WIDTH + x] = color;
+  }
+  uint16_t *getBuffer(void) const { return buffer; }
+
+private:
+  uint16_t *buffer;
+};
+
+#endif // _HOST_ADAFRUIT_GFX_H_
+
+/// @endcond
@@ -0,0 +1,93 @@
+// Stand-in for Adafruit BusIO's I2C device, backed by a simulated
+// IS31FL3741: writes are logged and land in a per-page register array,
+// so tests can inspect exactly what the library sent. Unlock and page
+// select (0xFE, 0xFD) are honored, other command registers are ignored.
+/// @cond HOST_TEST
+
+#ifndef _HOST_ADAFRUIT_I2CDEVICE_H_
+#define _HOST_ADAFRUIT_I2CDEVICE_H_
+
+#include <Arduino.h>
+
+struct I2CRecord {
+  uint8_t addr;               // 7-bit address written to
+  std::vector<uint8_t> bytes; // Register address followed by values
+};
+
+extern std::vector<I2CRecord> g_i2c_log; // Every write, in order
+extern uint8_t g_i2c_regs[5][256];       // Simulated registers, by page
+extern int g_i2c_page;                   // Selected page, -1 if none yet
+extern void (*g_i2c_hook)(void);         // If set, called after each write
+
+class Adafruit_I2CDevice {
+public:
+  Adafruit_I2CDevice(uint8_t addr, TwoWire *theWire = &Wire) : _addr(addr) {
+    (void)theWire;
+  }
+  bool begin(bool addr_detect = true) {
+    (void)addr_detect;
+    return true;
+  }
+  bool setSpeed(uint32_t desiredclk) {
+    (void)desiredclk;
+    return true;
+  }
+  size_t maxBufferSize(void) { return 32; }
+  uint8_t address(void) { return _addr; }
+  bool write(const uint8_t *buffer, size_t len, bool stop = true,
+             const uint8_t *prefix_buffer = NULL, size_t prefix_len = 0) {
+    (void)stop;
+    I2CRecord r;
+    r.addr = _addr;
+    if (prefix_buffer)
+      r.bytes.assign(prefix_buffer, prefix_buffer + prefix_len);
+    r.bytes.insert(r.bytes.end(), buffer, buffer + len);
+    g_i2c_log.push_back(r);
+    apply(r.bytes);
+    if (g_i2c_hook)
+      g_i2c_hook();
+    return true;
+  }
+  bool write_then_read(const uint8_t *write_buffer, size_t write_len,
+                       uint8_t *read_buffer, size_t read_len,
+                       bool stop = false) {
+    (void)write_len;
+    (void)stop;
+    uint8_t reg = write_buffer[0];
+    for (size_t i = 0; i < read_len; i++) {
+      if (reg == 0xFC) { // ID register reads back the address
+        read_buffer[i] = _addr * 2;
+      } else if (reg >= 0xF0) {
+        read_buffer[i] = 0;
+      } else {
+        read_buffer[i] = g_i2c_regs[(g_i2c_page < 0) ? 0 : g_i2c_page]
+                                   [(reg + i) & 0xFF];
+      }
+    }
+    return true;
+  }
+  bool read(uint8_t *buffer, size_t len, bool stop = true) {
+    (void)stop;
+    memset(buffer, 0, len);
+    return true;
+  }
+
+private:
+  void apply(const std::vector<uint8_t> &v) {
+    if (v.empty())
+      return;
+    if ((v[0] == 0xFD) && (v.size() > 1)) { // Page select
+      g_i2c_page = v[1];
+      return;
+    }
+    if ((v[0] >= 0xF0) || (g_i2c_page < 0) || (g_i2c_page > 4))
+      return;
+    for (size_t i = 1; i < v.size(); i++)
+      g_i2c_regs[g_i2c_page][(v[0] + i - 1) & 0xFF] = v[i];
+  }
+  uint8_t _addr;
+};
+
+#endif // _HOST_ADAFRUIT_I2CDEVICE_H_
+
+/// @endcond
@@ -0,0 +1,117 @@
+// Minimal stand-in for the Arduino core, so the library, the tests here and
+// a few example sketches can be built and run on a desktop host. Only what
+// those actually use is provided; nothing here is hardware-accurate.
+/// @cond HOST_TEST
+
+#ifndef _HOST_ARDUINO_H_
+#define _HOST_ARDUINO_H_
+
+// Standard headers that clash with the min() and max() macros go first
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_ptr(addr) (*(void *const *)(addr))
+#ifndef min
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#endif
+#define constrain(amt, low, high)                                              \
+  ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define noInterrupts()
+#define interrupts()
+#define HEX 16
+#define DEC 10
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield(void);
+long random(long howbig);
+long random(long howsmall, long howbig);
+
+class __FlashStringHelper;
+#define F(s) ((const __FlashStringHelper *)(s))
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buf, size_t len) {
+    size_t n = 0;
+    while (n < len)
+      n += write(buf[n]);
+    return n;
+  }
+  size_t print(const __FlashStringHelper *s) { return print((const char *)s); }
+  size_t print(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(unsigned char v, int base = DEC) {
+    return print((unsigned long)v, base);
+  }
+  size_t print(int v, int base = DEC) { return print((long)v, base); }
+  size_t print(unsigned int v, int base = DEC) {
+    return print((unsigned long)v, base);
+  }
+  size_t print(long v, int base = DEC) {
+    char buf[24];
+    snprintf(buf, sizeof buf, (base == HEX) ? "%lX" : "%ld", v);
+    return print(buf);
+  }
+  size_t print(unsigned long v, int base = DEC) {
+    char buf[24];
+    snprintf(buf, sizeof buf, (base == HEX) ? "%lX" : "%lu", v);
+    return print(buf);
+  }
+  size_t println(void) { return print("\r\n"); }
+  template <typename T> size_t println(T v) {
+    size_t n = print(v);
+    return n + println();
+  }
+  template <typename T> size_t println(T v, int base) {
+    size_t n = print(v, base);
+    return n + println();
+  }
+};
+
+class Stream : public Print {
+public:
+  virtual int available(void) = 0;
+  virtual int read(void) = 0;
+  virtual int peek(void) = 0;
+  void setTimeout(unsigned long ms) { (void)ms; }
+  size_t readBytes(uint8_t *buf, size_t len) {
+    size_t n = 0;
+    while ((n < len) && available())
+      buf[n++] = read();
+    return n;
+  }
+};
+
+class TwoWire {
+public:
+  void setClock(uint32_t hz) { (void)hz; }
+};
+
+extern TwoWire Wire;
+
+#endif // _HOST_ARDUINO_H_
+
+/// @endcond
@@ -0,0 +1,45 @@
+// Host implementations of the Arduino functions and globals declared in
+// the stub headers.
+/// @cond HOST_TEST
+
+#include <Adafruit_I2CDevice.h>
+
+TwoWire Wire;
+
+std::vector<I2CRecord> g_i2c_log;
+uint8_t g_i2c_regs[5][256];
+int g_i2c_page = -1;
+void (*g_i2c_hook)(void) = NULL;
+
+static const std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+
+unsigned long millis(void) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+unsigned long micros(void) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+void delay(unsigned long ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(unsigned int us) {
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield(void) {}
+
+long random(long howbig) { return howbig ? (rand() % howbig) : 0; }
+
+long random(long howsmall, long howbig) {
+  return howsmall + random(howbig - howsmall);
+}
+
+/// @endcond
@@ -0,0 +1,257 @@
+// Checks for specific bugs fixed in the past, one function each, against
+// the simulated chip. Each prints what failed; main() totals them up.
+/// @cond HOST_TEST
+
+#include <Adafruit_IS31FL3741.h>
+#include <limits.h>
+
+static int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);                   \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+// Scaling register for LED n in the simulated chip (pages 2 & 3)
+static uint8_t scaling(uint16_t n) {
+  return (n < 180) ? g_i2c_regs[2][n] : g_i2c_regs[3][n - 180];
+}
+
+// Zooms below 3 overflowed the int32_t transform steps
+static void testRotoZoom(void) {
+  IS3741_affine xform;
+  for (int32_t zoom = -2; zoom <= 4; zoom++) {
+    Adafruit_IS31FL3741_colorGFX_buffered::setRotoZoom(&xform, 0, zoom, 0, 0,
+                                                       0, 0);
+    CHECK(xform.a == (int32_t)(0x100000000LL / ((zoom < 3) ? 3 : zoom)));
+  }
+}
+
+// Exposes VM variables to check results
+class VM : public Adafruit_IS31FL3741_VM {
+public:
+  VM(Adafruit_IS31FL3741_colorGFX_buffered *display)
+      : Adafruit_IS31FL3741_VM(display) {}
+  int32_t var(uint8_t n) const { return _var[n]; }
+};
+
+// Apply op to INT32_MIN and b, return result
+static int32_t vmOp(Adafruit_IS31FL3741_colorGFX_buffered *display, uint8_t op,
+                    int8_t b) {
+  const uint8_t prog[] = {
+      IS3741_PUSH(-32768), IS3741_PUSH(16), IS3741_OP_SHL, // INT32_MIN
+      IS3741_OP_PUSH8, (uint8_t)b, op,                     // op b
+      IS3741_STORE(0), IS3741_OP_HALT};
+  VM vm(display);
+  vm.load(prog, sizeof prog);
+  CHECK(vm.run(100) == IS3741_VM_HALT);
+  return vm.var(0);
+}
+
+// INT32_MIN / -1 trapped, and overflowing ADD/SUB/MUL was undefined
+static void testVMArithmetic(void) {
+  Adafruit_IS31FL3741_QT_buffered matrix;
+  CHECK(vmOp(&matrix, IS3741_OP_DIV, -1) == INT32_MIN);
+  CHECK(vmOp(&matrix, IS3741_OP_MOD, -1) == 0);
+  CHECK(vmOp(&matrix, IS3741_OP_DIV, 0) == 0);
+  CHECK(vmOp(&matrix, IS3741_OP_MOD, 0) == 0);
+  CHECK(vmOp(&matrix, IS3741_OP_DIV, 2) == INT32_MIN / 2);
+  CHECK(vmOp(&matrix, IS3741_OP_MOD, 3) == INT32_MIN % 3);
+  CHECK(vmOp(&matrix, IS3741_OP_SUB, 1) == INT32_MAX);
+  CHECK(vmOp(&matrix, IS3741_OP_ADD, -1) == INT32_MAX);
+  CHECK(vmOp(&matrix, IS3741_OP_MUL, -1) == INT32_MIN);
+}
+
+// Counts drawPixel() calls, to catch draws that don't clip up front
+class CountingMatrix : public Adafruit_IS31FL3741_QT_buffered {
+public:
+  void drawPixel(int16_t x, int16_t y, uint16_t color) {
+    pixels++;
+    Adafruit_IS31FL3741_QT_buffered::drawPixel(x, y, color);
+  }
+  uint32_t pixels = 0;
+};
+
+// A huge RECT or HLINE from a loaded program took ~1e9 drawPixel() calls
+// in a single instruction, hanging the device despite the run() budget.
+static void testVMClipping(void) {
+  CountingMatrix matrix;
+  const uint8_t prog[] = {
+      IS3741_PUSH(0), IS3741_PUSH(0),             // RECT x y
+      IS3741_PUSH(32767), IS3741_PUSH(32767),     //   w h
+      IS3741_COLOR(0xFFFFFF), IS3741_OP_RECT,     //   color
+      IS3741_PUSH(-32768), IS3741_PUSH(4),        // HLINE x y
+      IS3741_PUSH(32767), IS3741_COLOR(0xFFFFFF), //   w color
+      IS3741_OP_HLINE, IS3741_OP_HALT};
+  VM vm(&matrix);
+  vm.load(prog, sizeof prog);
+  CHECK(vm.run(100) == IS3741_VM_HALT);
+  CHECK(matrix.pixels <= 2 * 13 * 9);
+  uint8_t *buf = matrix.getBuffer();
+  uint16_t lit = 0;
+  for (uint16_t i = 0; i < 351; i++)
+    lit += (buf[i] == 255);
+  CHECK(lit == 13 * 9 * 3);
+}
+
+// Wider than bloom()'s scratch row, LEDs in row-major order
+class WideMatrix : public Adafruit_IS31FL3741_colorGFX_buffered {
+public:
+  WideMatrix() : Adafruit_IS31FL3741_colorGFX_buffered(40, 4, IS3741_RGB) {}
+  void drawPixel(int16_t x, int16_t y, uint16_t color) {
+    (void)x, (void)y, (void)color;
+  }
+  bool mapPixel(int16_t x, int16_t y, uint16_t *idx) {
+    for (uint8_t i = 0; i < 3; i++)
+      idx[i] = ((y * 40 + x) * 3 + i) % 351;
+    return true;
+  }
+};
+
+// bloom() wrote past its 18-pixel scratch row on wider subclasses
+static void testBloomWidth(void) {
+  WideMatrix matrix;
+  uint8_t *buf = matrix.getBuffer();
+  memset(buf, 200, 351);
+  matrix.bloom(10, 255);
+  uint16_t changed = 0;
+  for (uint16_t i = 0; i < 351; i++)
+    changed += (buf[i] != 200);
+  CHECK(changed == 0);
+}
+
+// Exposes spectrum range to check it
+class Spectrum : public Adafruit_IS31FL3741_Spectrum {
+public:
+  Spectrum(Adafruit_IS31FL3741_colorGFX_buffered *display)
+      : Adafruit_IS31FL3741_Spectrum(display) {}
+  uint8_t floor(void) const { return _floor; }
+  uint8_t ceiling(void) const { return _ceiling; }
+};
+
+// A floor of 255 wrapped the ceiling around to 0
+static void testSpectrumRange(void) {
+  Adafruit_IS31FL3741_QT_buffered matrix;
+  Spectrum spectrum(&matrix);
+  spectrum.setRange(255, 0);
+  CHECK(spectrum.ceiling() > spectrum.floor());
+  spectrum.setRange(10, 5);
+  CHECK((spectrum.floor() == 10) && (spectrum.ceiling() == 11));
+}
+
+// Cooling range overflowed for some sizes, then divided by zero
+static void testFire(void) {
+  Adafruit_EyeLights_buffered glasses;
+  Adafruit_IS31FL3741_QT_buffered matrix;
+  Adafruit_IS31FL3741_Effects glassesFx(&glasses), matrixFx(&matrix);
+  for (int cooling = 0; cooling < 256; cooling++) {
+    glassesFx.fire(cooling, 120);
+    matrixFx.fire(cooling, 120);
+  }
+}
+
+// Gains didn't reach the EyeLights rings, and ring LEDs that are also
+// matrix pixels mustn't get them twice.
+static void testWhiteBalance(void) {
+  Adafruit_EyeLights_buffered glasses;
+  glasses.begin();
+  CHECK(glasses.setWhiteBalance(0x804020)); // Gains 129, 65, 33 of 256
+  // Paint each color to find which LEDs are which
+  uint8_t *buf = glasses.getBuffer();
+  uint8_t color[351];
+  memset(color, 3, sizeof color); // 3 = not an LED
+  const uint16_t rgb565[] = {0xF800, 0x07E0, 0x001F};
+  for (uint8_t c = 0; c < 3; c++) {
+    memset(buf, 0, 351);
+    glasses.fill(rgb565[c]);
+    glasses.left_ring.fill(0xFF0000 >> (c * 8));
+    glasses.right_ring.fill(0xFF0000 >> (c * 8));
+    for (uint16_t i = 0; i < 351; i++) {
+      if (buf[i])
+        color[i] = c;
+    }
+  }
+  const uint8_t expect[] = {128, 64, 32, 255};
+  uint16_t wrong = 0;
+  for (uint16_t i = 0; i < 351; i++)
+    wrong += (scaling(i) != expect[color[i]]);
+  CHECK(wrong == 0);
+}
+
+// writeRaw() left the cached PWM frequency stale
+static void testPWMFrequency(void) {
+  Adafruit_IS31FL3741 chip;
+  chip.begin();
+  CHECK(chip.getPWMFrequency() == IS3741_PWM_29KHZ);
+  CHECK(chip.setPWMFrequency(IS3741_PWM_LOWPOWER));
+  CHECK(g_i2c_regs[4][IS3741_FUNCREG_PWMFREQ] == IS3741_PWM_900HZ);
+  const uint8_t raw[] = {IS3741_FUNCREG_PWMFREQ, IS3741_PWM_1800HZ};
+  chip.writeRaw(raw, sizeof raw); // Page 4 is still selected
+  CHECK(chip.getPWMFrequency() == IS3741_PWM_1800HZ);
+}
+
+// Blink edges are one write only if page 4 is still selected
+static void testBlinkCost(void) {
+  Adafruit_IS31FL3741_QT_buffered matrix;
+  matrix.begin();
+  matrix.enable(true);
+  size_t n = g_i2c_log.size();
+  matrix.enable(false);
+  CHECK(g_i2c_log.size() - n == 1);
+  matrix.show();
+  n = g_i2c_log.size();
+  matrix.enable(true);
+  CHECK(g_i2c_log.size() - n == 3); // Unlock, page select, config
+}
+
+// Mirrored members, rotated and color-reordered, must match a buffered
+// object drawn the same way.
+static void testMirror(void) {
+  Adafruit_IS31FL3741_QT_buffered source(IS3741_RGB);
+  source.begin();
+  Adafruit_IS31FL3741 member;
+  member.begin();
+  for (uint8_t rotation = 0; rotation < 4; rotation++) {
+    for (uint8_t o = 0; o < 2; o++) {
+      IS3741_order order = o ? IS3741_BGR : IS3741_RGB;
+      Adafruit_IS31FL3741_Mirror mirror(&source);
+      bool added = mirror.add(&member, rotation, order);
+      CHECK(added == !(rotation & 1)); // No square boards
+      if (!added)
+        continue;
+      Adafruit_IS31FL3741_QT_buffered expect(order);
+      expect.setRotation(rotation);
+      for (int16_t y = 0; y < 9; y++) {
+        for (int16_t x = 0; x < 13; x++) {
+          uint16_t color = source.color565(x * 19, y * 28, x * y);
+          source.drawPixel(x, y, color);
+          expect.drawPixel(x, y, color);
+        }
+      }
+      mirror.show();
+      uint8_t *buf = expect.getBuffer();
+      CHECK(!memcmp(g_i2c_regs[0], buf, 180));
+      CHECK(!memcmp(g_i2c_regs[1], buf + 180, 171));
+    }
+  }
+}
+
+int main(void) {
+  testRotoZoom();
+  testVMArithmetic();
+  testVMClipping();
+  testBloomWidth();
+  testSpectrumRange();
+  testFire();
+  testWhiteBalance();
+  testPWMFrequency();
+  testBlinkCost();
+  testMirror();
+  printf(failures ? "FAIL\n" : "PASS\n");
+  return failures != 0;
+}
+
+/// @endcond